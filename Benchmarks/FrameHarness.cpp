@@ -0,0 +1,438 @@
+// Runs the real game loop (Game::RunFrame) headless on a fixed time step, over a scenario and an optional
+// input replay, and reports the frame and phase times (p50, p95, p99, max) and the allocations per frame, per
+// subsystem tag (the game sources are built with ASTEROIDS_TRACK_ALLOCATIONS, see AllocationTracker.hpp).
+// Exits with 2 when a budget is exceeded, so it can gate a build.
+//
+// Usage: FrameHarness [options]
+//   --scenario <preset|file|spec>  The world to run (default stress-1k)
+//   --replay <file>                Input to replay (see InputReplay.h)
+//   --seconds <s>                  Simulated seconds to run (default 10)
+//   --step <s>                     Fixed time step (default 1/60)
+//   --warmup <frames>              Frames left out of the statistics (default 30)
+//   --csv <file>                   Writes every frame's timings
+//   --json <file>                  Writes the summary
+//   --restarts <n>                 Restarts the game n times after the run and measures the live bytes growth
+//   --budget <key=value,...>       Budgets: frame time in ms (p50, p95, p99, max), mean allocations per frame (allocs),
+//                                  most allocations and bytes in a frame (frame_allocs, frame_bytes), most allocations
+//                                  of a tag in a frame (allocs.<tag>, e.g. allocs.Render), live bytes growth per
+//                                  restart (restart_growth) and the performance overlay's longest render in ms (hud,
+//                                  shows the overlay, see PerfHud::RENDER_BUDGET_MS)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+#include "InputReplay.h"
+
+namespace
+{
+	// A frame's timings and allocations
+	struct FrameRecord
+	{
+		FrameTimings mTimings;
+		AllocationTracker::Snapshot mAllocations;
+	};
+
+	// The statistics of one phase over the recorded frames
+	struct PhaseStats
+	{
+		double mP50 = 0.0;
+		double mP95 = 0.0;
+		double mP99 = 0.0;
+		double mMax = 0.0;
+		double mMean = 0.0;
+	};
+
+	// Nearest rank percentile of sorted values
+	double Percentile( const std::vector<double>& sorted, double percentile )
+	{
+		if ( sorted.empty() )
+		{
+			return 0.0;
+		}
+		std::size_t rank = static_cast< std::size_t >( percentile / 100.0 * sorted.size() + 0.5 );
+		return sorted[ std::min( sorted.size() - 1, rank > 0 ? rank - 1 : 0 ) ];
+	}
+
+	PhaseStats ComputeStats( std::vector<double> values )
+	{
+		PhaseStats stats;
+		if ( values.empty() )
+		{
+			return stats;
+		}
+		std::sort( values.begin(), values.end() );
+		stats.mP50 = Percentile( values, 50.0 );
+		stats.mP95 = Percentile( values, 95.0 );
+		stats.mP99 = Percentile( values, 99.0 );
+		stats.mMax = values.back();
+		for ( double value : values )
+		{
+			stats.mMean += value;
+		}
+		stats.mMean /= values.size();
+		return stats;
+	}
+
+	// A reported phase, and where its time is in FrameTimings
+	struct Phase
+	{
+		const char* mName;
+		double FrameTimings::* mField;
+	};
+
+	const Phase PHASES[] = {
+		{ "frame", &FrameTimings::mFrame },
+		{ "input", &FrameTimings::mInput },
+		{ "update", &FrameTimings::mUpdate },
+		{ "collision", &FrameTimings::mCollision },
+		{ "render_prep", &FrameTimings::mRenderPrep },
+		{ "present", &FrameTimings::mPresent },
+	};
+
+	// A tag's allocations per frame
+	struct AllocationStats
+	{
+		double mMeanAllocations = 0.0;
+		double mMeanBytes = 0.0;
+		uint64_t mMaxAllocations = 0;
+		uint64_t mMaxBytes = 0;
+	};
+
+	// Frames run after each restart of a restart cycle
+	const int RESTART_FRAMES = 10;
+
+	// A budget the run must stay under
+	struct Budget
+	{
+		std::string mKey;
+		double mLimit;
+	};
+
+	bool ParseBudgets( const std::string& text, std::vector<Budget>& outBudgets )
+	{
+		std::size_t start = 0;
+		while ( start < text.size() )
+		{
+			std::size_t end = text.find( ',', start );
+			std::string pair = text.substr( start, end == std::string::npos ? std::string::npos : end - start );
+			std::size_t equals = pair.find( '=' );
+			std::string key = pair.substr( 0, equals );
+			bool tagged = key.compare( 0, 7, "allocs." ) == 0 && key.size() > 7;
+			if ( equals == std::string::npos ||
+				 ( key != "p50" && key != "p95" && key != "p99" && key != "max" && key != "allocs" && key != "frame_allocs" &&
+				   key != "frame_bytes" && key != "restart_growth" && key != "hud" && !tagged ) )
+			{
+				printf( "Invalid budget '%s'!\n", pair.c_str() );
+				return false;
+			}
+			outBudgets.push_back( { key, std::atof( pair.c_str() + equals + 1 ) } );
+			if ( end == std::string::npos )
+			{
+				break;
+			}
+			start = end + 1;
+		}
+		return true;
+	}
+
+	bool HasBudget( const std::vector<Budget>& budgets, const char* key )
+	{
+		return std::any_of( budgets.begin(), budgets.end(), [ key ]( const Budget& budget ) { return budget.mKey == key; } );
+	}
+
+	// Escapes a string for a JSON string literal (a scenario loaded from a file is named by its path)
+	std::string JsonEscape( const std::string& text )
+	{
+		std::string escaped;
+		escaped.reserve( text.size() );
+		for ( char c : text )
+		{
+			if ( c == '"' || c == '\\' )
+			{
+				escaped += '\\';
+				escaped += c;
+			}
+			else if ( static_cast< unsigned char >( c ) < 0x20 )
+			{
+				char code[ 8 ];
+				snprintf( code, sizeof( code ), "\\u%04x", static_cast< unsigned char >( c ) );
+				escaped += code;
+			}
+			else
+			{
+				escaped += c;
+			}
+		}
+		return escaped;
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	std::string scenarioSource = "stress-1k";
+	std::string replayPath;
+	std::string csvPath;
+	std::string jsonPath;
+	double seconds = 10.0;
+	float step = 1.f / 60.f;
+	int warmup = 30;
+	int restarts = 0;
+	std::vector<Budget> budgets;
+
+	for ( int i = 1; i + 1 < argc; i += 2 )
+	{
+		const char* option = argv[ i ];
+		const char* value = argv[ i + 1 ];
+		if ( std::strcmp( option, "--scenario" ) == 0 ) scenarioSource = value;
+		else if ( std::strcmp( option, "--replay" ) == 0 ) replayPath = value;
+		else if ( std::strcmp( option, "--seconds" ) == 0 ) seconds = std::atof( value );
+		else if ( std::strcmp( option, "--step" ) == 0 ) step = static_cast< float >( std::atof( value ) );
+		else if ( std::strcmp( option, "--warmup" ) == 0 ) warmup = std::atoi( value );
+		else if ( std::strcmp( option, "--csv" ) == 0 ) csvPath = value;
+		else if ( std::strcmp( option, "--json" ) == 0 ) jsonPath = value;
+		else if ( std::strcmp( option, "--restarts" ) == 0 ) restarts = std::atoi( value );
+		else if ( std::strcmp( option, "--budget" ) == 0 )
+		{
+			if ( !ParseBudgets( value, budgets ) )
+			{
+				return 1;
+			}
+		}
+		else
+		{
+			printf( "Unknown option %s!\n", option );
+			return 1;
+		}
+	}
+
+	if ( !AllocationTracker::IsEnabled() )
+	{
+		printf( "Built without ASTEROIDS_TRACK_ALLOCATIONS, the allocations aren't counted!\n" );
+	}
+	// The growth is measured between restarts, so it takes at least two
+	if ( HasBudget( budgets, "restart_growth" ) )
+	{
+		restarts = std::max( restarts, 5 );
+	}
+
+	Scenario scenario;
+	if ( !Scenario::Load( scenarioSource, scenario ) )
+	{
+		return 1;
+	}
+	// The harness decides how long the run is
+	scenario.mDuration = 0.f;
+
+	InputReplay replay;
+	if ( !replayPath.empty() && !replay.Load( replayPath ) )
+	{
+		return 1;
+	}
+
+	Game* game = Game::GetInstance();
+	game->SetScenario( scenario );
+	if ( !game->Init( "FrameHarness", false, true ) )
+	{
+		printf( "Failed to initialize the game!\n" );
+		return 1;
+	}
+	game->SetFixedTimeStep( step );
+	// The overlay is only timed while it's shown
+	if ( HasBudget( budgets, "hud" ) )
+	{
+		game->GetPerfHud().Toggle();
+	}
+
+	// The loading screen isn't measured
+	while ( game->IsLoading() && game->GetIsRunning() )
+	{
+		game->RunFrame();
+	}
+
+	std::vector<FrameRecord> frames;
+	frames.reserve( static_cast< std::size_t >( seconds / step ) + 1 );
+	for ( int frame = 0; game->GetIsRunning() && game->GetSimTime() < seconds; ++frame )
+	{
+		replay.Apply( game->GetSimTime() );
+		game->RunFrame();
+
+		if ( frame >= warmup )
+		{
+			frames.push_back( { game->GetFrameTimings(), game->GetFrameAllocations() } );
+		}
+	}
+
+	// Restart cycles, each followed by a few frames so the previous world gets released.
+	// The first restart may still warm up caches, so the growth is averaged over the later ones.
+	std::vector<int64_t> restartLiveBytes;
+	for ( int restart = 0; restart < restarts && game->GetIsRunning(); ++restart )
+	{
+		game->RestartGame();
+		for ( int frame = 0; frame < RESTART_FRAMES && game->GetIsRunning(); ++frame )
+		{
+			game->RunFrame();
+		}
+		restartLiveBytes.push_back( AllocationTracker::GetLiveBytes() );
+	}
+	double restartGrowth = ( restartLiveBytes.size() >= 2 )
+		? static_cast< double >( restartLiveBytes.back() - restartLiveBytes.front() ) / ( restartLiveBytes.size() - 1 )
+		: 0.0;
+
+	// Statistics
+	std::vector<PhaseStats> phaseStats;
+	for ( const Phase& phase : PHASES )
+	{
+		std::vector<double> values;
+		values.reserve( frames.size() );
+		for ( const FrameRecord& record : frames )
+		{
+			values.push_back( record.mTimings.*phase.mField );
+		}
+		phaseStats.push_back( ComputeStats( std::move( values ) ) );
+	}
+
+	// Allocations, in total (tag -1) and per tag
+	const int tagCount = AllocationTracker::GetTagCount();
+	std::vector<AllocationStats> allocationStats( tagCount + 1 );
+	for ( int tag = -1; tag < tagCount; ++tag )
+	{
+		AllocationStats& stats = allocationStats[ tag + 1 ];
+		for ( const FrameRecord& record : frames )
+		{
+			const AllocationTracker::Counters& counters = ( tag < 0 ) ? record.mAllocations.mTotal : record.mAllocations.mTags[ tag ];
+			stats.mMeanAllocations += static_cast< double >( counters.mAllocations );
+			stats.mMeanBytes += static_cast< double >( counters.mBytes );
+			stats.mMaxAllocations = std::max( stats.mMaxAllocations, counters.mAllocations );
+			stats.mMaxBytes = std::max( stats.mMaxBytes, counters.mBytes );
+		}
+		stats.mMeanAllocations = frames.empty() ? 0.0 : stats.mMeanAllocations / frames.size();
+		stats.mMeanBytes = frames.empty() ? 0.0 : stats.mMeanBytes / frames.size();
+	}
+	const AllocationStats& totalAllocations = allocationStats[ 0 ];
+
+	// Budgets
+	const PhaseStats& frameStats = phaseStats[ 0 ];
+	std::vector<std::string> exceeded;
+	for ( const Budget& budget : budgets )
+	{
+		double value = 0.0;
+		if ( budget.mKey.compare( 0, 7, "allocs." ) == 0 )
+		{
+			// A tag nothing was charged to isn't registered, so it's within any budget
+			for ( int tag = 0; tag < tagCount; ++tag )
+			{
+				if ( budget.mKey.compare( 7, std::string::npos, AllocationTracker::GetTagName( tag ) ) == 0 )
+				{
+					value = static_cast< double >( allocationStats[ tag + 1 ].mMaxAllocations );
+				}
+			}
+		}
+		else
+		{
+			value = budget.mKey == "p50" ? frameStats.mP50
+				  : budget.mKey == "p95" ? frameStats.mP95
+				  : budget.mKey == "p99" ? frameStats.mP99
+				  : budget.mKey == "max" ? frameStats.mMax
+				  : budget.mKey == "allocs" ? totalAllocations.mMeanAllocations
+				  : budget.mKey == "frame_allocs" ? static_cast< double >( totalAllocations.mMaxAllocations )
+				  : budget.mKey == "frame_bytes" ? static_cast< double >( totalAllocations.mMaxBytes )
+				  : budget.mKey == "hud" ? game->GetPerfHud().GetMaxRenderTime()
+				  : restartGrowth;
+		}
+		if ( value > budget.mLimit )
+		{
+			printf( "Budget exceeded: %s is %.3f, the budget is %.3f\n", budget.mKey.c_str(), value, budget.mLimit );
+			exceeded.push_back( budget.mKey );
+		}
+	}
+
+	// Reports
+	printf( "phase,p50_ms,p95_ms,p99_ms,max_ms,mean_ms\n" );
+	for ( std::size_t p = 0; p < phaseStats.size(); ++p )
+	{
+		const PhaseStats& stats = phaseStats[ p ];
+		printf( "%s,%.3f,%.3f,%.3f,%.3f,%.3f\n", PHASES[ p ].mName, stats.mP50, stats.mP95, stats.mP99, stats.mMax, stats.mMean );
+	}
+	printf( "tag,mean_allocs,max_allocs,mean_bytes,max_bytes\n" );
+	for ( int tag = -1; tag < tagCount; ++tag )
+	{
+		const AllocationStats& stats = allocationStats[ tag + 1 ];
+		printf( "%s,%.1f,%llu,%.0f,%llu\n", ( tag < 0 ) ? "total" : AllocationTracker::GetTagName( tag ), stats.mMeanAllocations,
+				static_cast< unsigned long long >( stats.mMaxAllocations ), stats.mMeanBytes, static_cast< unsigned long long >( stats.mMaxBytes ) );
+	}
+	if ( game->GetPerfHud().IsVisible() )
+	{
+		printf( "hud,max_render_ms %.3f\n", game->GetPerfHud().GetMaxRenderTime() );
+	}
+	if ( !restartLiveBytes.empty() )
+	{
+		printf( "restarts,%zu,live_bytes %lld,growth_per_restart %.0f\n", restartLiveBytes.size(),
+				static_cast< long long >( restartLiveBytes.back() ), restartGrowth );
+	}
+
+	if ( !csvPath.empty() )
+	{
+		if ( FILE* csv = fopen( csvPath.c_str(), "w" ) )
+		{
+			fprintf( csv, "frame,frame_ms,input_ms,update_ms,collision_ms,render_prep_ms,present_ms,allocations,allocated_bytes\n" );
+			for ( std::size_t f = 0; f < frames.size(); ++f )
+			{
+				const FrameTimings& t = frames[ f ].mTimings;
+				const AllocationTracker::Counters& allocations = frames[ f ].mAllocations.mTotal;
+				fprintf( csv, "%zu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%llu,%llu\n", f, t.mFrame, t.mInput, t.mUpdate, t.mCollision,
+						 t.mRenderPrep, t.mPresent, static_cast< unsigned long long >( allocations.mAllocations ),
+						 static_cast< unsigned long long >( allocations.mBytes ) );
+			}
+			fclose( csv );
+		}
+		else
+		{
+			printf( "Failed to write %s!\n", csvPath.c_str() );
+		}
+	}
+
+	if ( !jsonPath.empty() )
+	{
+		if ( FILE* json = fopen( jsonPath.c_str(), "w" ) )
+		{
+			fprintf( json, "{\n  \"scenario\": \"%s\",\n  \"frames\": %zu,\n  \"step\": %.6f,\n  \"phases\": {\n",
+					 JsonEscape( scenario.mName ).c_str(), frames.size(), step );
+			for ( std::size_t p = 0; p < phaseStats.size(); ++p )
+			{
+				const PhaseStats& stats = phaseStats[ p ];
+				fprintf( json, "    \"%s\": { \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"mean\": %.4f }%s\n",
+						 JsonEscape( PHASES[ p ].mName ).c_str(), stats.mP50, stats.mP95, stats.mP99, stats.mMax, stats.mMean,
+						 p + 1 < phaseStats.size() ? "," : "" );
+			}
+			fprintf( json, "  },\n  \"allocations_per_frame\": {\n" );
+			for ( int tag = -1; tag < tagCount; ++tag )
+			{
+				const AllocationStats& stats = allocationStats[ tag + 1 ];
+				fprintf( json, "    \"%s\": { \"mean\": %.2f, \"max\": %llu, \"mean_bytes\": %.0f, \"max_bytes\": %llu }%s\n",
+						 JsonEscape( ( tag < 0 ) ? "total" : AllocationTracker::GetTagName( tag ) ).c_str(), stats.mMeanAllocations,
+						 static_cast< unsigned long long >( stats.mMaxAllocations ), stats.mMeanBytes,
+						 static_cast< unsigned long long >( stats.mMaxBytes ), tag + 1 < tagCount ? "," : "" );
+			}
+			fprintf( json, "  },\n  \"restarts\": %zu,\n  \"restart_growth\": %.0f,\n  \"budgets_exceeded\": [",
+					 restartLiveBytes.size(), restartGrowth );
+			for ( std::size_t e = 0; e < exceeded.size(); ++e )
+			{
+				fprintf( json, "%s\"%s\"", e > 0 ? ", " : "", JsonEscape( exceeded[ e ] ).c_str() );
+			}
+			fprintf( json, "]\n}\n" );
+			fclose( json );
+		}
+		else
+		{
+			printf( "Failed to write %s!\n", jsonPath.c_str() );
+		}
+	}
+
+	game->Clean();
+	return exceeded.empty() ? 0 : 2;
+}
@@ -0,0 +1,256 @@
+// Measures the game's hot functions at several entity counts, through the game's own code:
+// Game::DrawWireFrameModel, Game::IsPointInCircle, Ship::UpdateBullets, Ship::IsCollidingWithAsteroid,
+// Asteroid::Update and TextRenderer::UpdateText.
+// Nothing is shown on screen, the wire frames are flushed into a software renderer (drawing into a surface),
+// and the sounds go to the null audio backend. The results are printed as CSV.
+//
+// Usage: GameBenchmark [iterations] [counts...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+
+namespace
+{
+	// Every benchmark's asteroids and bullets come from the same seed
+	const unsigned SEED = 1234;
+
+	// The result of a benchmark at one entity count
+	struct Result
+	{
+		double mTotalNs = 0.0;
+		double mChecksum = 0.0;
+		// Entities processed per iteration, 0 for the entity count
+		int mEntities = 0;
+	};
+
+	double ElapsedNs( std::chrono::steady_clock::time_point start )
+	{
+		return static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start ).count() );
+	}
+
+	void PrintResult( const char* name, int count, int iterations, const Result& result )
+	{
+		double perIteration = result.mTotalNs / iterations;
+		int entities = result.mEntities > 0 ? result.mEntities : count;
+		printf( "%s,%d,%d,%.0f,%.2f\n", name, count, iterations, perIteration, perIteration / entities );
+		fprintf( stderr, "checksum %s %f\n", name, result.mChecksum );
+	}
+
+	// Replaces the game's asteroids with count random ones spread over the screen
+	void FillAsteroids( Game* game, int count )
+	{
+		std::mt19937 rng( SEED );
+		std::uniform_real_distribution<float> xDist( 0.f, static_cast< float >( SCREEN_WIDTH ) );
+		std::uniform_real_distribution<float> yDist( 0.f, static_cast< float >( SCREEN_HEIGHT ) );
+		std::uniform_real_distribution<float> velDist( -30.f, 30.f );
+		std::uniform_int_distribution<int> sizeDist( 24, 96 );
+
+		game->GetAsteroidsMap().clear();
+		for ( int i = 0; i < count; ++i )
+		{
+			game->AddAsteroid( SpaceObject( { xDist( rng ), yDist( rng ) }, { velDist( rng ), velDist( rng ) }, 0.f, sizeDist( rng ) ) );
+		}
+	}
+
+	Result BenchDrawWireFrameModel( Game* game, SDL_Renderer* renderer, int count, int iterations )
+	{
+		FillAsteroids( game, count );
+		Result result;
+		for ( int i = 0; i < iterations; ++i )
+		{
+			auto start = std::chrono::steady_clock::now();
+			for ( auto& a : game->GetAsteroidsMap() )
+			{
+				const SpaceObject& obj = a.second.GetSpaceObject();
+				game->DrawWireFrameModel( a.second.GetModel(), obj.mPosition.x, obj.mPosition.y, obj.mRotation,
+										  static_cast< float >( obj.mSize ), a.second.GetColor() );
+			}
+			result.mTotalNs += ElapsedNs( start );
+
+			// The batch is drawn into the software renderer outside of the measurement
+			result.mChecksum += game->GetLineBatcher().Flush( renderer );
+		}
+		return result;
+	}
+
+	Result BenchIsPointInCircle( Game* game, int count, int iterations )
+	{
+		std::mt19937 rng( SEED );
+		std::uniform_real_distribution<float> xDist( 0.f, static_cast< float >( SCREEN_WIDTH ) );
+		std::uniform_real_distribution<float> yDist( 0.f, static_cast< float >( SCREEN_HEIGHT ) );
+		std::vector<float> xs( count ), ys( count );
+		for ( int i = 0; i < count; ++i )
+		{
+			xs[ i ] = xDist( rng );
+			ys[ i ] = yDist( rng );
+		}
+
+		Result result;
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < iterations; ++i )
+		{
+			for ( int p = 0; p < count; ++p )
+			{
+				result.mChecksum += game->IsPointInCircle( 400.f, 300.f, 200.f, xs[ p ], ys[ p ] ) ? 1.0 : 0.0;
+			}
+		}
+		result.mTotalNs = ElapsedNs( start );
+		return result;
+	}
+
+	Result BenchUpdateBullets( Game* game, NullAudioBackend& audio, int count, int iterations )
+	{
+		FillAsteroids( game, count );
+		const std::unordered_map<int, Asteroid> asteroids = game->GetAsteroidsMap();
+
+		Result result;
+		for ( int i = 0; i < iterations; ++i )
+		{
+			// A bullet on every asteroid, so every bullet hits (or finds its asteroid already destroyed)
+			game->GetAsteroidsMap() = asteroids;
+			Ship ship( { 400.f, 300.f }, SDL_Color( 255, 0, 0, 255 ) );
+			for ( const auto& a : asteroids )
+			{
+				ship.AddBullet( SpaceObject( a.second.GetSpaceObject().mPosition, { 0.f, -200.f }, 0.f, 2 ) );
+			}
+			game->PackAsteroids();
+			game->GetAsteroidBroadphase().Build( game->GetAsteroidKinematics() );
+			ship.FindBulletHits( game->GetAsteroidBroadphase(), 0, ship.GetBulletCount() );
+
+			auto start = std::chrono::steady_clock::now();
+			ship.UpdateBullets();
+			result.mTotalNs += ElapsedNs( start );
+
+			result.mChecksum += static_cast< double >( game->GetAsteroidsMap().size() );
+			game->GetVoiceManager().Flush();
+			audio.ClearCalls();
+		}
+		return result;
+	}
+
+	Result BenchIsCollidingWithAsteroid( Game* game, int count, int iterations )
+	{
+		FillAsteroids( game, count );
+		game->PackAsteroids();
+		game->GetAsteroidBroadphase().Build( game->GetAsteroidKinematics() );
+
+		// The ship sweeps the screen, colliding with some of the asteroids
+		Ship ship( { 0.f, 0.f }, SDL_Color( 255, 0, 0, 255 ) );
+		const int positions = 256;
+
+		Result result;
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < iterations; ++i )
+		{
+			for ( int p = 0; p < positions; ++p )
+			{
+				SpaceObject& obj = ship.GetSpaceObject();
+				obj.mPosition = { static_cast< float >( p * 37 % SCREEN_WIDTH ), static_cast< float >( p * 53 % SCREEN_HEIGHT ) };
+				obj.mRotation = p * 0.1f;
+				result.mChecksum += ship.IsCollidingWithAsteroid( game->GetAsteroidBroadphase() ) ? 1.0 : 0.0;
+			}
+		}
+		result.mTotalNs = ElapsedNs( start );
+		// Reported per ship position, the asteroid count only changes the grid's density
+		result.mEntities = positions;
+		return result;
+	}
+
+	Result BenchAsteroidUpdate( Game* game, int count, int iterations )
+	{
+		FillAsteroids( game, count );
+		Result result;
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < iterations; ++i )
+		{
+			for ( auto& a : game->GetAsteroidsMap() )
+			{
+				a.second.Update( 0.016f );
+			}
+		}
+		result.mTotalNs = ElapsedNs( start );
+		result.mChecksum = game->GetAsteroidsMap().begin()->second.GetSpaceObject().mRotation;
+		return result;
+	}
+
+	Result BenchUpdateText( int count, int iterations )
+	{
+		// Two texts of count characters, alternated so every call lays the text out again
+		std::string texts[ 2 ] = { std::string( count, 'A' ), std::string( count, 'B' ) };
+		TextRenderer text( "", 20, SDL_Color( 255, 255, 255, 255 ) );
+		text.CreateText();
+
+		Result result;
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < iterations; ++i )
+		{
+			text.UpdateText( texts[ i % 2 ] );
+			result.mChecksum += text.GetTextSize().x;
+		}
+		result.mTotalNs = ElapsedNs( start );
+		return result;
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	int iterations = argc > 1 ? std::atoi( argv[ 1 ] ) : 100;
+	std::vector<int> counts;
+	for ( int i = 2; i < argc; ++i )
+	{
+		counts.push_back( std::atoi( argv[ i ] ) );
+	}
+	if ( counts.empty() )
+	{
+		counts = { 100, 1000, 10000 };
+	}
+
+	if ( SDL_Init( 0 ) < 0 || TTF_Init() != 0 )
+	{
+		printf( "Failed to initialize SDL! SDL_Error: %s\n", SDL_GetError() );
+		return 1;
+	}
+
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat( 0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32 );
+	SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer( surface ) : nullptr;
+	if ( renderer == nullptr )
+	{
+		printf( "Failed to create the software renderer! SDL_Error: %s\n", SDL_GetError() );
+		return 1;
+	}
+
+	Game* game = Game::GetInstance();
+	auto audio = std::make_unique<NullAudioBackend>();
+	NullAudioBackend& nullAudio = *audio;
+	game->SetAudioBackend( std::move( audio ) );
+
+	// The text renderers pick the atlas up from the FontManager
+	FontManager::get()->Preload( renderer, FontManager::GetDefaultFontPath(), { 20 } );
+
+	printf( "benchmark,count,iterations,ns_per_iteration,ns_per_entity\n" );
+	for ( int count : counts )
+	{
+		PrintResult( "DrawWireFrameModel", count, iterations, BenchDrawWireFrameModel( game, renderer, count, iterations ) );
+		PrintResult( "IsPointInCircle", count, iterations, BenchIsPointInCircle( game, count, iterations ) );
+		PrintResult( "UpdateBullets", count, iterations, BenchUpdateBullets( game, nullAudio, count, iterations ) );
+		PrintResult( "IsCollidingWithAsteroid", count, iterations, BenchIsCollidingWithAsteroid( game, count, iterations ) );
+		PrintResult( "AsteroidUpdate", count, iterations, BenchAsteroidUpdate( game, count, iterations ) );
+		PrintResult( "UpdateText", count, iterations, BenchUpdateText( count, iterations ) );
+	}
+
+	game->GetAsteroidsMap().clear();
+	FontManager::get()->Clean();
+	AssetCache::get()->Clean();
+	SDL_DestroyRenderer( renderer );
+	SDL_FreeSurface( surface );
+	TTF_Quit();
+	SDL_Quit();
+	return 0;
+}
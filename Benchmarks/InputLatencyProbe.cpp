@@ -0,0 +1,149 @@
+// Measures the game's input to photon latency (see InputLatency.h) in one present mode: a thread pushes key
+// presses into SDL's event queue at random moments, like a player would, and the game records when each one is
+// polled, which tick consumes it and when the frame showing it is presented. Run it once per present mode to
+// compare them; it opens a window, vsync needs a real display. The frame pacing statistics (see FramePacer.hpp)
+// cover the last frames of the run.
+//
+// Usage: InputLatencyProbe [options]
+//   --mode <vsync|uncapped|limited[:fps]>  The present mode (default vsync)
+//   --scenario <preset|file|spec>          The world to run (default classic)
+//   --seconds <s>                          Seconds to measure (default 10)
+//   --rate <presses>                       Presses per second, on average (default 10)
+//   --csv <file>                           Writes every press
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "Game.h"
+
+namespace
+{
+	// The key pressed, it fires a bullet
+	const SDL_Scancode PROBE_KEY = SDL_SCANCODE_SPACE;
+	// Frames run after the last press, so every press gets presented
+	const int DRAIN_FRAMES = 4;
+
+	void PushKey( Uint32 type )
+	{
+		SDL_Event event;
+		SDL_zero( event );
+		event.type = type;
+		event.key.state = ( type == SDL_KEYDOWN ) ? SDL_PRESSED : SDL_RELEASED;
+		event.key.keysym.scancode = PROBE_KEY;
+		event.key.keysym.sym = SDL_GetKeyFromScancode( PROBE_KEY );
+		// SDL stamps the event, like the presses coming from the OS
+		SDL_PushEvent( &event );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	std::string modeSpec = "vsync";
+	std::string scenarioSource = "classic";
+	double seconds = 10.0;
+	double rate = 10.0;
+	const char* csvPath = nullptr;
+
+	for ( int i = 1; i + 1 < argc; i += 2 )
+	{
+		const char* option = argv[ i ];
+		const char* value = argv[ i + 1 ];
+		if ( std::strcmp( option, "--mode" ) == 0 ) modeSpec = value;
+		else if ( std::strcmp( option, "--scenario" ) == 0 ) scenarioSource = value;
+		else if ( std::strcmp( option, "--seconds" ) == 0 ) seconds = std::atof( value );
+		else if ( std::strcmp( option, "--rate" ) == 0 ) rate = std::atof( value );
+		else if ( std::strcmp( option, "--csv" ) == 0 ) csvPath = value;
+		else
+		{
+			printf( "Unknown option %s!\n", option );
+			return 1;
+		}
+	}
+
+	PresentMode mode = PresentMode::VSYNC;
+	float targetFps = 60.f;
+	if ( !FramePacer::ParseMode( modeSpec.c_str(), mode, targetFps ) )
+	{
+		printf( "Unknown present mode %s!\n", modeSpec.c_str() );
+		return 1;
+	}
+	if ( rate <= 0.0 )
+	{
+		printf( "The press rate must be above 0!\n" );
+		return 1;
+	}
+
+	Scenario scenario;
+	if ( !Scenario::Load( scenarioSource, scenario ) )
+	{
+		return 1;
+	}
+	// The probe decides when the run ends
+	scenario.mDuration = 0.f;
+
+	Game* game = Game::GetInstance();
+	game->SetScenario( scenario );
+	game->GetFramePacer().SetMode( mode, targetFps );
+	if ( !game->Init( "InputLatencyProbe", false ) )
+	{
+		printf( "Failed to initialize the game!\n" );
+		return 1;
+	}
+
+	while ( game->IsLoading() && game->GetIsRunning() )
+	{
+		game->RunFrame();
+	}
+	game->GetInputLatency().SetEnabled( true );
+
+	// The presses come at random moments of the frame, the gaps between them are exponential
+	std::atomic<bool> pressing{ true };
+	std::thread presser( [ &pressing, rate ]()
+		{
+			std::mt19937 rng( 1234 );
+			std::exponential_distribution<double> gap( rate );
+			while ( pressing.load() )
+			{
+				std::this_thread::sleep_for( std::chrono::duration<double>( gap( rng ) ) );
+				PushKey( SDL_KEYDOWN );
+				PushKey( SDL_KEYUP );
+			}
+		} );
+
+	int frames = 0;
+	auto start = std::chrono::steady_clock::now();
+	while ( game->GetIsRunning() && std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() < seconds )
+	{
+		game->RunFrame();
+		++frames;
+	}
+	double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+	pressing = false;
+	presser.join();
+
+	for ( int frame = 0; frame < DRAIN_FRAMES && game->GetIsRunning(); ++frame )
+	{
+		game->RunFrame();
+	}
+
+	const InputLatency& latency = game->GetInputLatency();
+	const std::string modeName = game->GetFramePacer().GetName();
+	PacingStats pacing = game->GetFramePacer().GetStats();
+	printf( "mode,frames,fps,interval_mean_ms,jitter_ms,p99_deviation_ms,max_deviation_ms,pending_presses\n" );
+	printf( "%s,%d,%.1f,%.3f,%.3f,%.3f,%.3f,%zu\n", modeName.c_str(), frames, frames / elapsed, pacing.mMeanMs,
+			pacing.mJitterMs, pacing.mP99DeviationMs, pacing.mMaxDeviationMs, latency.GetPendingCount() );
+	latency.PrintSummary( modeName.c_str() );
+	if ( csvPath != nullptr )
+	{
+		latency.WriteCsv( csvPath, modeName.c_str() );
+	}
+
+	game->Clean();
+	return 0;
+}
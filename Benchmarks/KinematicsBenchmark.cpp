@@ -0,0 +1,69 @@
+// Measures the throughput (objects per nanosecond) of the kinematics kernel (see Kinematics.h)
+// for every backend compiled into this build: Scalar, SSE2 and (when built with AVX2 enabled) AVX2.
+//
+// Usage: KinematicsBenchmark [objects] [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Kinematics.h"
+
+namespace
+{
+	// Fills a batch with random objects spread over (and slightly beyond) the screen
+	void FillBatch( KinematicsBatch& batch, std::size_t count )
+	{
+		std::mt19937 rng( 1234 );
+		std::uniform_real_distribution<float> posDist( -100.f, 900.f );
+		std::uniform_real_distribution<float> velDist( -30.f, 30.f );
+		std::uniform_int_distribution<int> sizeDist( 24, 96 );
+
+		batch.Clear();
+		batch.Reserve( count );
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			batch.Push( SpaceObject( { posDist( rng ), posDist( rng ) }, { velDist( rng ), velDist( rng ) }, 0.f, sizeDist( rng ) ) );
+		}
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	std::size_t objects = argc > 1 ? std::strtoul( argv[ 1 ], nullptr, 10 ) : 100000;
+	int iterations = argc > 2 ? std::atoi( argv[ 2 ] ) : 1000;
+
+	const KinematicsBackend backends[] = { KinematicsBackend::Scalar, KinematicsBackend::SSE2, KinematicsBackend::AVX2 };
+
+	printf( "backend,objects,iterations,ns_total,objects_per_ns\n" );
+	for ( KinematicsBackend backend : backends )
+	{
+		if ( !Kinematics::IsBackendAvailable( backend ) )
+		{
+			continue;
+		}
+
+		KinematicsBatch batch;
+		FillBatch( batch, objects );
+
+		// Warm up
+		Kinematics::IntegrateRange( batch, 0, batch.Size(), 0.016f, true, backend );
+
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < iterations; ++i )
+		{
+			Kinematics::IntegrateRange( batch, 0, batch.Size(), 0.016f, true, backend );
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		double ns = static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() );
+		double objectsPerNs = static_cast< double >( objects ) * iterations / ns;
+
+		// Print a position so the work can't be optimized away
+		printf( "%s,%zu,%d,%.0f,%.3f\n", Kinematics::GetBackendName( backend ), objects, iterations, ns, objectsPerNs );
+		fprintf( stderr, "checksum %f\n", batch.mPositionsX[ objects / 2 ] );
+	}
+
+	return 0;
+}
@@ -0,0 +1,205 @@
+// Restarts the game over and over (headless, see FrameHarness) and checks restarting neither leaks nor slows down:
+// after the warmup the resident memory and the live heap bytes must stay flat, and the restarts must stay under a
+// latency budget. Exits with 2 when a budget is exceeded, so it can gate a build.
+//
+// Usage: RestartSoak [options]
+//   --scenario <preset|file|spec>  The world every restart builds (default classic, a random seed becomes 1)
+//   --restarts <n>                 Restarts to run (default 100000)
+//   --frames <n>                   Frames run between two restarts (default 1)
+//   --warmup <n>                   Restarts left out, they fill the pools and the caches (default 100, 0 measures
+//                                  from the freshly started game)
+//   --latency <ms>                 Budget of the p99 restart time (default 1)
+//   --rss <KiB>                    Budget of the resident memory growth after the warmup (default 1024)
+//   --live <bytes>                 Budget of the live heap bytes growth after the warmup (default 4096, a tolerance
+//                                  for one-time lazy initialisations, a leak grows with every restart)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Game.h"
+
+namespace
+{
+	// The process' resident memory in bytes, 0 when it can't be read
+	std::size_t GetResidentBytes()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		return GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) ? counters.WorkingSetSize : 0;
+#else
+		long pages = 0;
+		long residentPages = 0;
+		FILE* statm = fopen( "/proc/self/statm", "r" );
+		if ( statm == nullptr )
+		{
+			return 0;
+		}
+		bool read = fscanf( statm, "%ld %ld", &pages, &residentPages ) == 2;
+		fclose( statm );
+		return read ? static_cast< std::size_t >( residentPages ) * sysconf( _SC_PAGESIZE ) : 0;
+#endif
+	}
+
+	// Nearest rank percentile of sorted values
+	double Percentile( const std::vector<double>& sorted, double percentile )
+	{
+		if ( sorted.empty() )
+		{
+			return 0.0;
+		}
+		std::size_t rank = static_cast< std::size_t >( percentile / 100.0 * sorted.size() + 0.5 );
+		return sorted[ std::min( sorted.size() - 1, rank > 0 ? rank - 1 : 0 ) ];
+	}
+
+	double Mean( std::vector<double>::const_iterator begin, std::vector<double>::const_iterator end )
+	{
+		double sum = 0.0;
+		for ( auto it = begin; it != end; ++it )
+		{
+			sum += *it;
+		}
+		return begin == end ? 0.0 : sum / ( end - begin );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	std::string scenarioSource = "classic";
+	int restarts = 100000;
+	int frames = 1;
+	int warmup = 100;
+	double latencyBudget = 1.0;
+	double rssBudget = 1024.0;
+	double liveBudget = 4096.0;
+
+	for ( int i = 1; i + 1 < argc; i += 2 )
+	{
+		const char* option = argv[ i ];
+		const char* value = argv[ i + 1 ];
+		if ( std::strcmp( option, "--scenario" ) == 0 ) scenarioSource = value;
+		else if ( std::strcmp( option, "--restarts" ) == 0 ) restarts = std::atoi( value );
+		else if ( std::strcmp( option, "--frames" ) == 0 ) frames = std::atoi( value );
+		else if ( std::strcmp( option, "--warmup" ) == 0 ) warmup = std::atoi( value );
+		else if ( std::strcmp( option, "--latency" ) == 0 ) latencyBudget = std::atof( value );
+		else if ( std::strcmp( option, "--rss" ) == 0 ) rssBudget = std::atof( value );
+		else if ( std::strcmp( option, "--live" ) == 0 ) liveBudget = std::atof( value );
+		else
+		{
+			printf( "Unknown option %s!\n", option );
+			return 1;
+		}
+	}
+
+	Scenario scenario;
+	if ( !Scenario::Load( scenarioSource, scenario ) )
+	{
+		return 1;
+	}
+	// Every restart builds the same world, so the memory it needs doesn't change
+	scenario.mDuration = 0.f;
+	scenario.mSeed = ( scenario.mSeed != 0 ) ? scenario.mSeed : 1;
+
+	Game* game = Game::GetInstance();
+	game->SetScenario( scenario );
+	if ( !game->Init( "RestartSoak", false, true ) )
+	{
+		printf( "Failed to initialize the game!\n" );
+		return 1;
+	}
+	game->SetFixedTimeStep( 1.f / 60.f );
+
+	while ( game->IsLoading() && game->GetIsRunning() )
+	{
+		game->RunFrame();
+	}
+
+	// Not even with ASTEROIDS_LOG_RESTARTS set, one line per restart would drown the report
+	game->SetLogRestarts( false );
+
+	std::vector<double> latencies;
+	latencies.reserve( restarts );
+	std::size_t rssStart = 0;
+	int64_t liveStart = 0;
+	// Without a warmup the baseline is the freshly started game
+	bool hasBaseline = ( warmup <= 0 );
+	if ( hasBaseline )
+	{
+		rssStart = GetResidentBytes();
+		liveStart = AllocationTracker::GetLiveBytes();
+	}
+	for ( int restart = 0; restart < restarts && game->GetIsRunning(); ++restart )
+	{
+		game->RestartGame();
+		for ( int frame = 0; frame < frames; ++frame )
+		{
+			game->RunFrame();
+		}
+
+		if ( restart + 1 == warmup )
+		{
+			rssStart = GetResidentBytes();
+			liveStart = AllocationTracker::GetLiveBytes();
+			hasBaseline = true;
+		}
+		else if ( restart >= warmup )
+		{
+			latencies.push_back( game->GetLastRestartTime() );
+		}
+	}
+	std::size_t rssEnd = GetResidentBytes();
+	int64_t liveEnd = AllocationTracker::GetLiveBytes();
+
+	// Statistics, the first and last thousand restarts show whether restarting slows down
+	std::size_t window = std::min<std::size_t>( 1000, latencies.size() );
+	double earlyMean = Mean( latencies.begin(), latencies.begin() + window );
+	double lateMean = Mean( latencies.end() - window, latencies.end() );
+	std::vector<double> sorted = latencies;
+	std::sort( sorted.begin(), sorted.end() );
+	double p99 = Percentile( sorted, 99.0 );
+	double rssGrowth = ( static_cast< double >( rssEnd ) - static_cast< double >( rssStart ) ) / 1024.0;
+	double liveGrowth = static_cast< double >( liveEnd - liveStart );
+
+	printf( "restarts,p50_ms,p99_ms,max_ms,first_1000_mean_ms,last_1000_mean_ms\n" );
+	printf( "%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n", latencies.size(), Percentile( sorted, 50.0 ), p99,
+			sorted.empty() ? 0.0 : sorted.back(), earlyMean, lateMean );
+	printf( "memory,rss_start_kib,rss_end_kib,live_start_bytes,live_end_bytes\n" );
+	printf( "memory,%zu,%zu,%lld,%lld\n", rssStart / 1024, rssEnd / 1024, static_cast< long long >( liveStart ),
+			static_cast< long long >( liveEnd ) );
+
+	// Budgets
+	bool exceeded = false;
+	if ( p99 > latencyBudget )
+	{
+		printf( "Budget exceeded: the p99 restart takes %.4f ms, the budget is %.4f ms\n", p99, latencyBudget );
+		exceeded = true;
+	}
+	if ( !hasBaseline )
+	{
+		printf( "The warmup took every restart, the memory budgets aren't checked\n" );
+	}
+	if ( hasBaseline && rssStart != 0 && rssGrowth > rssBudget )
+	{
+		printf( "Budget exceeded: the resident memory grew by %.0f KiB, the budget is %.0f KiB\n", rssGrowth, rssBudget );
+		exceeded = true;
+	}
+	if ( hasBaseline && AllocationTracker::IsEnabled() && liveGrowth > liveBudget )
+	{
+		printf( "Budget exceeded: the live heap grew by %.0f bytes, the budget is %.0f bytes\n", liveGrowth, liveBudget );
+		exceeded = true;
+	}
+
+	game->Clean();
+	return exceeded ? 2 : 0;
+}
@@ -0,0 +1,75 @@
+// Measures the cost of the timer wheel (see TimerWheel.hpp) per timer, at several timer counts: scheduling,
+// cancelling half of them, and running the game loop (60 frames per second) until the rest fired.
+// The delays are spread over a minute, like gameplay timers (respawns, power-ups, waves).
+//
+// Usage: TimerWheelBenchmark [counts...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "TimerWheel.hpp"
+
+namespace
+{
+	double ElapsedNs( std::chrono::steady_clock::time_point start )
+	{
+		return static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count() );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	std::vector<std::size_t> counts;
+	for ( int i = 1; i < argc; ++i )
+	{
+		counts.push_back( std::strtoul( argv[ i ], nullptr, 10 ) );
+	}
+	if ( counts.empty() )
+	{
+		counts = { 1000, 10000, 100000, 1000000 };
+	}
+
+	const uint64_t FRAME_MS = 16;
+	const uint64_t MAX_DELAY_MS = 60000;
+
+	printf( "timers,schedule_ns_per_timer,cancel_ns_per_timer,advance_ns_per_frame,fired\n" );
+	for ( std::size_t count : counts )
+	{
+		std::mt19937 rng( 1234 );
+		std::uniform_int_distribution<uint64_t> delayDist( 1, MAX_DELAY_MS );
+		venture::TimerWheel wheel;
+		std::vector<venture::TimerHandle> timers;
+		timers.reserve( count );
+		std::size_t fired = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			timers.push_back( wheel.Schedule( delayDist( rng ), [ &fired ]() { ++fired; } ) );
+		}
+		double scheduleNs = ElapsedNs( start );
+
+		start = std::chrono::steady_clock::now();
+		for ( std::size_t i = 0; i < count; i += 2 )
+		{
+			wheel.Cancel( timers[ i ] );
+		}
+		double cancelNs = ElapsedNs( start );
+
+		std::size_t frames = 0;
+		start = std::chrono::steady_clock::now();
+		for ( uint64_t now = FRAME_MS; wheel.GetPendingCount() > 0; now += FRAME_MS )
+		{
+			wheel.AdvanceTo( now );
+			++frames;
+		}
+		double advanceNs = ElapsedNs( start );
+
+		printf( "%zu,%.2f,%.2f,%.1f,%zu\n", count, scheduleNs / count, cancelNs / ( ( count + 1 ) / 2 ),
+				advanceNs / frames, fired );
+	}
+	return 0;
+}
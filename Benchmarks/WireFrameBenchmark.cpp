@@ -0,0 +1,149 @@
+// Compares the fused affine wire frame transform (Transform2D) with the original per-vertex
+// DrawWireFrameModel code, for models of 3 (ship), 20 (asteroid) and 64 vertices.
+// The original code's SDL_RenderDrawLineF calls are replaced with recording the line end points.
+//
+// Usage: WireFrameBenchmark [models] [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Transform2D.h"
+
+namespace
+{
+	// The recorded lines (x1, y1, x2, y2)
+	std::vector<float> gRecordedLines;
+
+	// The wire frame code as it was before the fused transform
+	void LegacyDrawWireFrameModel( const std::vector<std::pair<float, float>>& vecModelCoordinates, float x, float y, float r, float s )
+	{
+		std::vector<std::pair<float, float>> vecTransformedCoordinates;
+		auto verts = vecModelCoordinates.size();
+		vecTransformedCoordinates.resize( verts );
+
+		for ( std::size_t i = 0; i < verts; i++ )
+		{
+			vecTransformedCoordinates[ i ].first = vecModelCoordinates[ i ].first * cosf( r ) - vecModelCoordinates[ i ].second * sinf( r );
+			vecTransformedCoordinates[ i ].second = vecModelCoordinates[ i ].first * sinf( r ) + vecModelCoordinates[ i ].second * cosf( r );
+		}
+
+		for ( std::size_t i = 0; i < verts; i++ )
+		{
+			vecTransformedCoordinates[ i ].first *= s;
+			vecTransformedCoordinates[ i ].second *= s;
+		}
+
+		for ( std::size_t i = 0; i < verts; i++ )
+		{
+			vecTransformedCoordinates[ i ].first += x;
+			vecTransformedCoordinates[ i ].second += y;
+		}
+
+		for ( std::size_t i = 0; i < verts; i++ )
+		{
+			std::size_t j = ( i + 1 ) % verts;
+
+			auto ax = static_cast< double >( vecTransformedCoordinates[ i ].first );
+			auto ay = static_cast< double >( vecTransformedCoordinates[ i ].second );
+			auto bx = static_cast< double >( vecTransformedCoordinates[ j ].first );
+			auto by = static_cast< double >( vecTransformedCoordinates[ j ].second );
+
+			auto clampToIntRange = []( double value )
+				{
+					constexpr double Max = std::numeric_limits<float>::max();
+					constexpr double Min = std::numeric_limits<float>::min();
+					return static_cast< int >( std::max( Min, std::min( Max, value ) ) );
+				};
+
+			gRecordedLines.push_back( static_cast< float >( clampToIntRange( ax ) ) );
+			gRecordedLines.push_back( static_cast< float >( clampToIntRange( ay ) ) );
+			gRecordedLines.push_back( static_cast< float >( clampToIntRange( bx ) ) );
+			gRecordedLines.push_back( static_cast< float >( clampToIntRange( by ) ) );
+		}
+	}
+
+	// Builds a jagged circle model
+	std::vector<std::pair<float, float>> MakeModel( int verts, std::mt19937& rng )
+	{
+		std::uniform_real_distribution<float> noiseDist( 0.8f, 1.2f );
+		std::vector<std::pair<float, float>> model;
+		for ( int i = 0; i < verts; i++ )
+		{
+			float noise = noiseDist( rng );
+			model.emplace_back( noise * sinf( ( ( float ) i / ( float ) verts ) * 6.28318f ),
+								noise * cosf( ( ( float ) i / ( float ) verts ) * 6.28318f ) );
+		}
+		return model;
+	}
+
+	template<typename F>
+	double MeasureNs( int iterations, F&& function )
+	{
+		auto start = std::chrono::steady_clock::now();
+		for ( int i = 0; i < iterations; ++i )
+		{
+			function();
+		}
+		auto end = std::chrono::steady_clock::now();
+		return static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	int models = argc > 1 ? std::atoi( argv[ 1 ] ) : 2000;
+	int iterations = argc > 2 ? std::atoi( argv[ 2 ] ) : 200;
+
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution<float> posDist( 0.f, 800.f );
+	std::uniform_real_distribution<float> rotDist( -3.f, 3.f );
+
+	printf( "vertices,models,legacy_ns_per_model,fused_ns_per_model,speedup\n" );
+	for ( int verts : { 3, 20, 64 } )
+	{
+		auto model = MakeModel( verts, rng );
+
+		std::vector<float> xs( models ), ys( models ), rs( models );
+		for ( int m = 0; m < models; ++m )
+		{
+			xs[ m ] = posDist( rng );
+			ys[ m ] = posDist( rng );
+			rs[ m ] = rotDist( rng );
+		}
+
+		gRecordedLines.reserve( static_cast< std::size_t >( models ) * verts * 4 );
+		double legacyNs = MeasureNs( iterations, [ & ]()
+			{
+				gRecordedLines.clear();
+				for ( int m = 0; m < models; ++m )
+				{
+					LegacyDrawWireFrameModel( model, xs[ m ], ys[ m ], rs[ m ], 40.f );
+				}
+			} );
+
+		// The fused path writes into a line batch like buffer (one closing vertex per model)
+		std::vector<SDL_FPoint> batch( static_cast< std::size_t >( models ) * ( verts + 1 ) );
+		double fusedNs = MeasureNs( iterations, [ & ]()
+			{
+				for ( int m = 0; m < models; ++m )
+				{
+					SDL_FPoint* out = &batch[ static_cast< std::size_t >( m ) * ( verts + 1 ) ];
+					Transform2D::FromRotationScaleTranslation( xs[ m ], ys[ m ], rs[ m ], 40.f ).Apply( model.data(), model.size(), out );
+					out[ verts ] = out[ 0 ];
+				}
+			} );
+
+		double perModel = static_cast< double >( models ) * iterations;
+		printf( "%d,%d,%.1f,%.1f,%.2f\n", verts, models, legacyNs / perModel, fusedNs / perModel, legacyNs / fusedNs );
+		fprintf( stderr, "checksum %f %f\n", gRecordedLines[ 0 ], batch[ 0 ].x );
+	}
+
+	return 0;
+}
@@ -13,6 +13,17 @@
 int main(int argc, char* argv[])
 {
 	auto game = Game::GetInstance();
+
+	// The first argument picks a scenario: a preset name (e.g. stress-10k), a spec file or an inline spec
+	if ( argc > 1 )
+	{
+		Scenario scenario;
+		if ( !Scenario::Load( argv[ 1 ], scenario ) )
+		{
+			return 1;
+		}
+		game->SetScenario( scenario );
+	}
 	
 	if(!game->Init("MTN95-AsteroidsRemake", false))
 		printf("Failed to initialize game!");
@@ -0,0 +1,339 @@
+#include "AllocationTracker.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include <SDL2/SDL.h>
+
+namespace venture
+{
+	namespace
+	{
+		// A tag's counters
+		struct TagCounters
+		{
+			std::atomic<uint64_t> mAllocations{ 0 };
+			std::atomic<uint64_t> mBytes{ 0 };
+		};
+
+		TagCounters sTags[ AllocationTracker::MAX_TAGS ];
+		std::atomic<int64_t> sLiveBytes{ 0 };
+
+		// Registered tag names, only written under sTagsMutex
+		const char* sTagNames[ AllocationTracker::MAX_TAGS ] = { "Untagged" };
+		std::atomic<int> sTagCount{ 1 };
+		std::mutex sTagsMutex;
+
+		thread_local int tCurrentTag = 0;
+	}
+
+	AllocationTracker::Snapshot AllocationTracker::Snapshot::Since( const Snapshot& earlier ) const
+	{
+		Snapshot delta;
+		delta.mTotal.mAllocations = mTotal.mAllocations - earlier.mTotal.mAllocations;
+		delta.mTotal.mBytes = mTotal.mBytes - earlier.mTotal.mBytes;
+		for ( int tag = 0; tag < MAX_TAGS; ++tag )
+		{
+			delta.mTags[ tag ].mAllocations = mTags[ tag ].mAllocations - earlier.mTags[ tag ].mAllocations;
+			delta.mTags[ tag ].mBytes = mTags[ tag ].mBytes - earlier.mTags[ tag ].mBytes;
+		}
+		delta.mLiveBytes = mLiveBytes - earlier.mLiveBytes;
+		return delta;
+	}
+
+	bool AllocationTracker::IsEnabled()
+	{
+#ifdef ASTEROIDS_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	uint64_t AllocationTracker::GetAllocationCount()
+	{
+		uint64_t count = 0;
+		for ( const TagCounters& tag : sTags )
+		{
+			count += tag.mAllocations.load( std::memory_order_relaxed );
+		}
+		return count;
+	}
+
+	uint64_t AllocationTracker::GetAllocatedBytes()
+	{
+		uint64_t bytes = 0;
+		for ( const TagCounters& tag : sTags )
+		{
+			bytes += tag.mBytes.load( std::memory_order_relaxed );
+		}
+		return bytes;
+	}
+
+	int64_t AllocationTracker::GetLiveBytes()
+	{
+		return sLiveBytes.load( std::memory_order_relaxed );
+	}
+
+	AllocationTracker::Snapshot AllocationTracker::TakeSnapshot()
+	{
+		Snapshot snapshot;
+		for ( int tag = 0; tag < MAX_TAGS; ++tag )
+		{
+			snapshot.mTags[ tag ].mAllocations = sTags[ tag ].mAllocations.load( std::memory_order_relaxed );
+			snapshot.mTags[ tag ].mBytes = sTags[ tag ].mBytes.load( std::memory_order_relaxed );
+			snapshot.mTotal.mAllocations += snapshot.mTags[ tag ].mAllocations;
+			snapshot.mTotal.mBytes += snapshot.mTags[ tag ].mBytes;
+		}
+		snapshot.mLiveBytes = sLiveBytes.load( std::memory_order_relaxed );
+		return snapshot;
+	}
+
+	int AllocationTracker::RegisterTag( const char* name )
+	{
+		std::lock_guard<std::mutex> lock( sTagsMutex );
+		int count = sTagCount.load( std::memory_order_relaxed );
+		for ( int tag = 0; tag < count; ++tag )
+		{
+			if ( std::strcmp( sTagNames[ tag ], name ) == 0 )
+			{
+				return tag;
+			}
+		}
+
+		if ( count == MAX_TAGS )
+		{
+			return 0;
+		}
+		sTagNames[ count ] = name;
+		sTagCount.store( count + 1, std::memory_order_release );
+		return count;
+	}
+
+	const char* AllocationTracker::GetTagName( int tag )
+	{
+		return ( tag >= 0 && tag < sTagCount.load( std::memory_order_acquire ) ) ? sTagNames[ tag ] : "Unknown";
+	}
+
+	int AllocationTracker::GetTagCount()
+	{
+		return sTagCount.load( std::memory_order_acquire );
+	}
+
+	int AllocationTracker::GetCurrentTag()
+	{
+		return tCurrentTag;
+	}
+
+	void AllocationTracker::SetCurrentTag( int tag )
+	{
+		tCurrentTag = tag;
+	}
+
+#ifdef ASTEROIDS_TRACK_ALLOCATIONS
+	namespace
+	{
+		// Every block starts with a header (keeping the default new alignment) recording its size,
+		// so freeing a block takes its bytes off the live bytes
+		struct alignas( __STDCPP_DEFAULT_NEW_ALIGNMENT__ ) BlockHeader
+		{
+			std::size_t mSize;
+		};
+
+		// Over-aligned blocks keep where their malloc block starts too, the header sits right before the aligned memory
+		struct AlignedBlockHeader
+		{
+			void* mBlock;
+			std::size_t mSize;
+		};
+
+		void Charge( std::size_t size )
+		{
+			int tag = tCurrentTag;
+			sTags[ tag ].mAllocations.fetch_add( 1, std::memory_order_relaxed );
+			sTags[ tag ].mBytes.fetch_add( size, std::memory_order_relaxed );
+			sLiveBytes.fetch_add( static_cast< int64_t >( size ), std::memory_order_relaxed );
+		}
+
+		void* Allocate( std::size_t size )
+		{
+			auto* header = static_cast< BlockHeader* >( std::malloc( sizeof( BlockHeader ) + size ) );
+			if ( header == nullptr )
+			{
+				return nullptr;
+			}
+
+			header->mSize = size;
+			Charge( size );
+			return header + 1;
+		}
+
+		void Free( void* memory )
+		{
+			if ( memory == nullptr )
+			{
+				return;
+			}
+
+			BlockHeader* header = static_cast< BlockHeader* >( memory ) - 1;
+			sLiveBytes.fetch_sub( static_cast< int64_t >( header->mSize ), std::memory_order_relaxed );
+			std::free( header );
+		}
+
+		void* AllocateAligned( std::size_t size, std::size_t alignment )
+		{
+			void* block = std::malloc( sizeof( AlignedBlockHeader ) + alignment + size );
+			if ( block == nullptr )
+			{
+				return nullptr;
+			}
+
+			// The alignments are powers of two above the default new alignment, so the header stays aligned too
+			std::uintptr_t memory = ( reinterpret_cast< std::uintptr_t >( block ) + sizeof( AlignedBlockHeader ) + alignment - 1 ) & ~( alignment - 1 );
+			AlignedBlockHeader* header = reinterpret_cast< AlignedBlockHeader* >( memory ) - 1;
+			header->mBlock = block;
+			header->mSize = size;
+			Charge( size );
+			return reinterpret_cast< void* >( memory );
+		}
+
+		void FreeAligned( void* memory )
+		{
+			if ( memory == nullptr )
+			{
+				return;
+			}
+
+			AlignedBlockHeader* header = static_cast< AlignedBlockHeader* >( memory ) - 1;
+			sLiveBytes.fetch_sub( static_cast< int64_t >( header->mSize ), std::memory_order_relaxed );
+			std::free( header->mBlock );
+		}
+
+		// SDL's allocator, its blocks have the same header as operator new's
+
+		void* SDLCALL SdlMalloc( std::size_t size )
+		{
+			return Allocate( size );
+		}
+
+		void* SDLCALL SdlCalloc( std::size_t count, std::size_t size )
+		{
+			if ( size != 0 && count > SIZE_MAX / size )
+			{
+				return nullptr;
+			}
+			void* memory = Allocate( count * size );
+			if ( memory != nullptr )
+			{
+				std::memset( memory, 0, count * size );
+			}
+			return memory;
+		}
+
+		void* SDLCALL SdlRealloc( void* memory, std::size_t size )
+		{
+			if ( memory == nullptr )
+			{
+				return Allocate( size );
+			}
+
+			// Counted as a new allocation of the new size, the old size leaves the live bytes
+			BlockHeader* header = static_cast< BlockHeader* >( memory ) - 1;
+			std::size_t oldSize = header->mSize;
+			auto* resized = static_cast< BlockHeader* >( std::realloc( header, sizeof( BlockHeader ) + size ) );
+			if ( resized == nullptr )
+			{
+				return nullptr;
+			}
+
+			resized->mSize = size;
+			sLiveBytes.fetch_sub( static_cast< int64_t >( oldSize ), std::memory_order_relaxed );
+			Charge( size );
+			return resized + 1;
+		}
+
+		void SDLCALL SdlFree( void* memory )
+		{
+			Free( memory );
+		}
+	}
+#endif
+
+	void AllocationTracker::HookSdlAllocations()
+	{
+#ifdef ASTEROIDS_TRACK_ALLOCATIONS
+		if ( SDL_SetMemoryFunctions( SdlMalloc, SdlCalloc, SdlRealloc, SdlFree ) != 0 )
+		{
+			printf( "(AllocationTracker): Failed to hook SDL's allocations: %s\n", SDL_GetError() );
+		}
+#endif
+	}
+}
+
+#ifdef ASTEROIDS_TRACK_ALLOCATIONS
+
+// The array variants forward to these by default
+void* operator new( std::size_t size )
+{
+	if ( void* memory = venture::Allocate( size ) )
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return venture::Allocate( size );
+}
+
+void operator delete( void* memory ) noexcept
+{
+	venture::Free( memory );
+}
+
+void operator delete( void* memory, std::size_t ) noexcept
+{
+	venture::Free( memory );
+}
+
+void operator delete( void* memory, const std::nothrow_t& ) noexcept
+{
+	venture::Free( memory );
+}
+
+// Over-aligned types (alignas above the default new alignment)
+void* operator new( std::size_t size, std::align_val_t alignment )
+{
+	if ( void* memory = venture::AllocateAligned( size, static_cast< std::size_t >( alignment ) ) )
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new( std::size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	return venture::AllocateAligned( size, static_cast< std::size_t >( alignment ) );
+}
+
+void operator delete( void* memory, std::align_val_t ) noexcept
+{
+	venture::FreeAligned( memory );
+}
+
+void operator delete( void* memory, std::size_t, std::align_val_t ) noexcept
+{
+	venture::FreeAligned( memory );
+}
+
+void operator delete( void* memory, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+	venture::FreeAligned( memory );
+}
+
+#endif
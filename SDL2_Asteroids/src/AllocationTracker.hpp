@@ -0,0 +1,163 @@
+/**
+ * @class AllocationTracker
+ * @brief Counts the process' heap allocations, through replacements of the global operator new and delete
+ * (the aligned ones too) and, once HookSdlAllocations() ran, of SDL's allocator (SDL_malloc and friends, which
+ * hold the sound chunks, surfaces and textures' pixels).
+ *
+ * Every allocation is charged to the calling thread's current tag (a subsystem such as "Update" or "Render",
+ * set with ALLOCATION_TAG for the rest of a scope), so a frame's churn can be broken down by subsystem.
+ * The live bytes (allocated and not freed yet) are tracked too, which shows memory growing across restarts.
+ *
+ * The replacements are only compiled in when ASTEROIDS_TRACK_ALLOCATIONS is defined, otherwise
+ * IsEnabled() returns false, the counts stay at 0 and ALLOCATION_TAG compiles to nothing.
+ * Counting is a few relaxed atomic adds per allocation, cheap enough to leave on while profiling.
+ *
+ * Example usage:
+ * @code
+ * void Game::Render()
+ * {
+ *     ALLOCATION_TAG( "Render" );
+ *     ...
+ * }
+ * auto start = venture::AllocationTracker::TakeSnapshot();
+ * RunFrame();
+ * auto frame = venture::AllocationTracker::TakeSnapshot().Since( start );
+ * printf( "%llu allocations, %llu in Render\n", frame.mTotal.mAllocations,
+ *         frame.mTags[ venture::AllocationTracker::RegisterTag( "Render" ) ].mAllocations );
+ * @endcode
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace venture
+{
+	class AllocationTracker
+	{
+	public:
+		// Maximum number of tags, tag 0 is "Untagged"
+		static const int MAX_TAGS = 16;
+
+		// Allocations made and bytes allocated
+		struct Counters
+		{
+			uint64_t mAllocations = 0;
+			uint64_t mBytes = 0;
+		};
+
+		// The counters at one point in time (or, from Since(), between two points in time)
+		struct Snapshot
+		{
+			// Every allocation
+			Counters mTotal;
+			// Allocations per tag
+			std::array<Counters, MAX_TAGS> mTags;
+			// Bytes allocated and not freed yet
+			int64_t mLiveBytes = 0;
+
+			/**
+			 * @brief Returns the allocations made between an earlier snapshot and this one.
+			 */
+			Snapshot Since( const Snapshot& earlier ) const;
+		};
+
+		/**
+		 * @brief Checks if the allocations are counted (built with ASTEROIDS_TRACK_ALLOCATIONS).
+		 */
+		static bool IsEnabled();
+
+		/**
+		 * @brief Counts SDL's allocations too (SDL_SetMemoryFunctions), does nothing unless IsEnabled().
+		 * Must run before the first SDL call that may allocate (before SDL_SetHint and SDL_Init): a block SDL
+		 * allocated before can't be freed through the tracker.
+		 */
+		static void HookSdlAllocations();
+
+		/**
+		 * @brief Returns the number of allocations made since the process started.
+		 */
+		static uint64_t GetAllocationCount();
+
+		/**
+		 * @brief Returns the number of bytes allocated since the process started (freed bytes aren't subtracted).
+		 */
+		static uint64_t GetAllocatedBytes();
+
+		/**
+		 * @brief Returns the number of bytes allocated and not freed yet.
+		 */
+		static int64_t GetLiveBytes();
+
+		/**
+		 * @brief Returns every counter.
+		 */
+		static Snapshot TakeSnapshot();
+
+		/**
+		 * @brief Returns the id of a tag, registering it on first use (once MAX_TAGS are registered, returns 0).
+		 * @param name The tag's name, must stay valid (a string literal).
+		 */
+		static int RegisterTag( const char* name );
+
+		/**
+		 * @brief Returns a tag's name.
+		 */
+		static const char* GetTagName( int tag );
+
+		/**
+		 * @brief Returns the number of registered tags (including "Untagged").
+		 */
+		static int GetTagCount();
+
+		/**
+		 * @brief Returns the calling thread's tag.
+		 */
+		static int GetCurrentTag();
+
+		/**
+		 * @brief Sets the calling thread's tag.
+		 */
+		static void SetCurrentTag( int tag );
+	};
+
+	/**
+	 * @brief Charges the calling thread's allocations to a tag until it's destroyed (then restores the previous tag).
+	 */
+	class AllocationScope
+	{
+	public:
+		explicit AllocationScope( int tag )
+			: mPreviousTag( AllocationTracker::GetCurrentTag() )
+		{
+			AllocationTracker::SetCurrentTag( tag );
+		}
+
+		~AllocationScope()
+		{
+			AllocationTracker::SetCurrentTag( mPreviousTag );
+		}
+
+	private:
+		int mPreviousTag;
+
+		AllocationScope( const AllocationScope& ) = delete;
+		AllocationScope& operator=( const AllocationScope& ) = delete;
+	};
+}
+
+#ifdef ASTEROIDS_TRACK_ALLOCATIONS
+
+#define ALLOCATION_TAG_CONCAT_INNER( a, b ) a##b
+#define ALLOCATION_TAG_CONCAT( a, b ) ALLOCATION_TAG_CONCAT_INNER( a, b )
+
+// Charges the rest of the enclosing scope's allocations to a tag
+#define ALLOCATION_TAG( name ) \
+	static const int ALLOCATION_TAG_CONCAT( allocationTagId, __LINE__ ) = venture::AllocationTracker::RegisterTag( name ); \
+	venture::AllocationScope ALLOCATION_TAG_CONCAT( allocationScope, __LINE__ )( ALLOCATION_TAG_CONCAT( allocationTagId, __LINE__ ) )
+
+#else
+
+#define ALLOCATION_TAG( name ) ( ( void )0 )
+
+#endif
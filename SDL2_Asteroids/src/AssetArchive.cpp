@@ -0,0 +1,194 @@
+#include "AssetArchive.hpp"
+#include "AssetArchiveFormat.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace venture
+{
+	AssetArchive::~AssetArchive()
+	{
+		Close();
+	}
+
+	bool AssetArchive::Open( const std::string& archivePath, const std::string& assetRoot )
+	{
+		Close();
+
+		if ( !Map( archivePath ) )
+		{
+			return false;
+		}
+
+		using namespace AssetArchiveFormat;
+
+		// Validate the header and the table of contents before trusting any offset
+		const Header* header = reinterpret_cast< const Header* >( mData );
+		if ( mSize < sizeof( Header ) || std::memcmp( header->mMagic, MAGIC, sizeof( MAGIC ) ) != 0 || header->mVersion != VERSION )
+		{
+			printf( "%s is not a valid asset archive!\n", archivePath.c_str() );
+			Close();
+			return false;
+		}
+
+		const std::size_t tocEnd = sizeof( Header ) + static_cast< std::size_t >( header->mEntryCount ) * sizeof( TocEntry );
+		if ( tocEnd > mSize )
+		{
+			printf( "The asset archive %s is truncated!\n", archivePath.c_str() );
+			Close();
+			return false;
+		}
+
+		const TocEntry* toc = reinterpret_cast< const TocEntry* >( mData + sizeof( Header ) );
+		mEntries.reserve( header->mEntryCount );
+		for ( uint32_t i = 0; i < header->mEntryCount; ++i )
+		{
+			const TocEntry& entry = toc[ i ];
+			std::size_t pathLength = strnlen( entry.mPath, MAX_PATH_LENGTH );
+			if ( pathLength == MAX_PATH_LENGTH || entry.mOffset > mSize || entry.mSize > mSize - entry.mOffset )
+			{
+				printf( "The asset archive %s has a corrupted entry (%u)!\n", archivePath.c_str(), i );
+				Close();
+				return false;
+			}
+
+			mEntries.emplace( std::string_view( entry.mPath, pathLength ),
+							  Entry{ mData + entry.mOffset, static_cast< std::size_t >( entry.mSize ) } );
+		}
+
+		mAssetRoot = assetRoot;
+		return true;
+	}
+
+	void AssetArchive::Close()
+	{
+		mEntries.clear();
+		mAssetRoot.clear();
+		Unmap();
+	}
+
+	SDL_RWops* AssetArchive::OpenAsset( const std::string& path ) const
+	{
+		if ( !IsOpen() )
+		{
+			return nullptr;
+		}
+
+		// Packed paths are relative to the asset root, with '/' separators
+		std::string relativePath = path.compare( 0, mAssetRoot.size(), mAssetRoot ) == 0 ? path.substr( mAssetRoot.size() ) : path;
+		for ( char& c : relativePath )
+		{
+			c = ( c == '\\' ) ? '/' : c;
+		}
+
+		auto it = mEntries.find( relativePath );
+		if ( it == mEntries.end() )
+		{
+			return nullptr;
+		}
+
+		return SDL_RWFromConstMem( it->second.mData, static_cast< int >( it->second.mSize ) );
+	}
+
+#ifdef _WIN32
+	bool AssetArchive::Map( const std::string& archivePath )
+	{
+		HANDLE file = CreateFileA( archivePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if ( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 )
+		{
+			CloseHandle( file );
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+		if ( mapping == nullptr )
+		{
+			CloseHandle( file );
+			return false;
+		}
+
+		void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+		if ( data == nullptr )
+		{
+			CloseHandle( mapping );
+			CloseHandle( file );
+			return false;
+		}
+
+		mData = static_cast< const unsigned char* >( data );
+		mSize = static_cast< std::size_t >( size.QuadPart );
+		mFileHandle = file;
+		mMappingHandle = mapping;
+		return true;
+	}
+
+	void AssetArchive::Unmap()
+	{
+		if ( mData != nullptr )
+		{
+			UnmapViewOfFile( mData );
+			CloseHandle( static_cast< HANDLE >( mMappingHandle ) );
+			CloseHandle( static_cast< HANDLE >( mFileHandle ) );
+		}
+		mData = nullptr;
+		mSize = 0;
+		mFileHandle = nullptr;
+		mMappingHandle = nullptr;
+	}
+#else
+	bool AssetArchive::Map( const std::string& archivePath )
+	{
+		int file = open( archivePath.c_str(), O_RDONLY );
+		if ( file < 0 )
+		{
+			return false;
+		}
+
+		struct stat info;
+		if ( fstat( file, &info ) != 0 || info.st_size == 0 )
+		{
+			close( file );
+			return false;
+		}
+
+		// The mapping stays valid once the descriptor is closed
+		void* data = mmap( nullptr, static_cast< std::size_t >( info.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+		close( file );
+		if ( data == MAP_FAILED )
+		{
+			return false;
+		}
+
+		mData = static_cast< const unsigned char* >( data );
+		mSize = static_cast< std::size_t >( info.st_size );
+		return true;
+	}
+
+	void AssetArchive::Unmap()
+	{
+		if ( mData != nullptr )
+		{
+			munmap( const_cast< unsigned char* >( mData ), mSize );
+		}
+		mData = nullptr;
+		mSize = 0;
+	}
+#endif
+}
@@ -0,0 +1,115 @@
+/**
+ * @class AssetArchive
+ * @brief A packed asset archive (see AssetArchiveFormat.h), memory-mapped in one go.
+ *
+ * Opening the archive maps the whole file and indexes its table of contents, after that
+ * an asset is opened as an SDL_RWops over the mapped bytes, without any file system access.
+ * Assets are looked up by their loose file path, the asset root prefix is stripped first.
+ *
+ * Example usage:
+ * @code
+ * venture::AssetArchive archive;
+ * if ( archive.Open( "Assets.pak", "Assets/" ) )
+ * {
+ *     SDL_RWops* file = archive.OpenAsset( "Assets/LaserShoot.wav" ); // null if it isn't packed
+ *     Mix_Chunk* laser = Mix_LoadWAV_RW( file, 1 );
+ * }
+ * @endcode
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <SDL2/SDL.h>
+
+namespace venture
+{
+	class AssetArchive
+	{
+	public:
+
+		/// Constructors & Destructors
+		///--------------------------------------------------------
+
+		AssetArchive() = default;
+
+		/**
+		 * @brief Destructor for the AssetArchive class, unmaps the archive.
+		 */
+		~AssetArchive();
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Maps an archive and indexes its entries.
+		 * @param archivePath The archive file.
+		 * @param assetRoot The loose assets folder the archive was packed from (stripped from looked up paths).
+		 * @return true on success, false if the file is missing or isn't a valid archive.
+		 */
+		bool Open( const std::string& archivePath, const std::string& assetRoot );
+
+		/**
+		 * @brief Unmaps the archive. Assets opened from it must not be used anymore.
+		 */
+		void Close();
+
+		/**
+		 * @brief Opens a packed asset as a read-only SDL_RWops over the mapped bytes.
+		 * @param path The asset's loose file path.
+		 * @return The stream (to be closed by the caller), null if the asset isn't in the archive.
+		 */
+		SDL_RWops* OpenAsset( const std::string& path ) const;
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Checks if an archive is mapped.
+		 */
+		bool IsOpen() const { return mData != nullptr; }
+
+		/**
+		 * @brief Returns the number of packed assets.
+		 */
+		std::size_t GetEntryCount() const { return mEntries.size(); }
+
+	private:
+		// A packed asset's bytes in the mapping
+		struct Entry
+		{
+			const unsigned char* mData;
+			std::size_t mSize;
+		};
+
+		/**
+		 * @brief Maps the whole file read-only (platform specific).
+		 */
+		bool Map( const std::string& archivePath );
+
+		/**
+		 * @brief Releases the mapping (platform specific).
+		 */
+		void Unmap();
+
+	private:
+		// The mapped archive
+		const unsigned char* mData = nullptr;
+		std::size_t mSize = 0;
+		// Platform mapping handles (Windows only)
+		void* mFileHandle = nullptr;
+		void* mMappingHandle = nullptr;
+
+		// The loose assets folder, stripped from looked up paths
+		std::string mAssetRoot;
+		// The packed assets, keyed by path relative to the asset root (the views point in the mapping)
+		std::unordered_map<std::string_view, Entry> mEntries;
+
+		// Deleted constructors and assignment operators
+		AssetArchive( const AssetArchive& ) = delete;
+		AssetArchive& operator=( const AssetArchive& ) = delete;
+	};
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of the packed asset archive (Assets.pak), written by Tools/AssetPacker
+// and memory-mapped at runtime by venture::AssetArchive.
+//
+//   Header
+//   TocEntry[ mEntryCount ]
+//   entry data, each entry starting on an ALIGNMENT boundary
+//
+// Every field is little-endian. Paths are relative to the Assets folder, with '/' separators.
+
+namespace AssetArchiveFormat
+{
+	// Identifies an asset archive
+	const char MAGIC[ 4 ] = { 'V', 'P', 'A', 'K' };
+	// Bumped whenever the layout changes
+	const uint32_t VERSION = 1;
+	// Alignment of every entry's data, in bytes
+	const uint32_t ALIGNMENT = 16;
+	// Longest entry path, including the terminating null
+	const std::size_t MAX_PATH_LENGTH = 112;
+
+	struct Header
+	{
+		char mMagic[ 4 ];
+		uint32_t mVersion;
+		uint32_t mEntryCount;
+		uint32_t mAlignment;
+	};
+
+	struct TocEntry
+	{
+		// Offset of the entry's data from the start of the archive
+		uint64_t mOffset;
+		// Size of the entry's data
+		uint64_t mSize;
+		// Null terminated path, relative to the Assets folder
+		char mPath[ MAX_PATH_LENGTH ];
+	};
+
+	static_assert( sizeof( Header ) == 16, "The archive header must stay 16 bytes" );
+	static_assert( sizeof( TocEntry ) == 128, "The table of contents entries must stay 128 bytes" );
+}
@@ -0,0 +1,181 @@
+#include "AssetCache.hpp"
+
+#include <cstdio>
+
+#include <SDL2/SDL_image.h>
+
+namespace venture
+{
+	AssetCache* AssetCache::s_Instance = nullptr;
+
+	bool AssetCache::MountArchive( const std::string& archivePath, const std::string& assetRoot )
+	{
+		if ( !mArchive.Open( archivePath, assetRoot ) )
+		{
+			printf( "No asset archive at %s, loading the loose asset files\n", archivePath.c_str() );
+			return false;
+		}
+		return true;
+	}
+
+	SDL_RWops* AssetCache::OpenFile( const std::string& path ) const
+	{
+		if ( SDL_RWops* packed = mArchive.OpenAsset( path ) )
+		{
+			return packed;
+		}
+		return SDL_RWFromFile( path.c_str(), "rb" );
+	}
+
+	template<typename T>
+	std::shared_ptr<T> AssetCache::Find( const std::string& key )
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		auto it = mAssets.find( key );
+		if ( it == mAssets.end() )
+		{
+			++mMissCount;
+			return nullptr;
+		}
+
+		++mHitCount;
+		return std::static_pointer_cast< T >( it->second.mAsset );
+	}
+
+	template<typename T>
+	std::shared_ptr<T> AssetCache::Insert( const std::string& key, std::shared_ptr<T> asset, std::size_t bytes )
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		auto [ it, inserted ] = mAssets.try_emplace( key, Entry{ asset, bytes } );
+		if ( inserted )
+		{
+			mResidentBytes += bytes;
+		}
+		return std::static_pointer_cast< T >( it->second.mAsset );
+	}
+
+	std::shared_ptr<Mix_Chunk> AssetCache::LoadSound( const std::string& path )
+	{
+		if ( auto sound = Find<Mix_Chunk>( path ) )
+		{
+			return sound;
+		}
+
+		SDL_RWops* file = OpenFile( path );
+		Mix_Chunk* chunk = file != nullptr ? Mix_LoadWAV_RW( file, 1 ) : nullptr;
+		if ( chunk == nullptr )
+		{
+			printf( "Failed to load the sound %s! Error: %s\n", path.c_str(), Mix_GetError() );
+			return nullptr;
+		}
+
+		return Insert( path, std::shared_ptr<Mix_Chunk>( chunk, Mix_FreeChunk ), chunk->alen );
+	}
+
+	std::shared_ptr<TTF_Font> AssetCache::LoadFont( const std::string& path, int size )
+	{
+		std::string key = path + "#" + std::to_string( size );
+		if ( auto font = Find<TTF_Font>( key ) )
+		{
+			return font;
+		}
+
+		SDL_RWops* file = OpenFile( path );
+		if ( file == nullptr )
+		{
+			printf( "Failed to open the font %s! Error: %s\n", path.c_str(), SDL_GetError() );
+			return nullptr;
+		}
+
+		// The font keeps reading glyphs from the file (or the mapping), so its size is what stays resident
+		Sint64 bytes = SDL_RWsize( file );
+		TTF_Font* font = nullptr;
+		{
+			std::lock_guard<std::mutex> lock( mFontMutex );
+			font = TTF_OpenFontRW( file, 1, size );
+		}
+		if ( font == nullptr )
+		{
+			printf( "Failed to open the font %s! Error: %s\n", path.c_str(), TTF_GetError() );
+			return nullptr;
+		}
+
+		return Insert( key, std::shared_ptr<TTF_Font>( font, TTF_CloseFont ), bytes > 0 ? static_cast< std::size_t >( bytes ) : 0 );
+	}
+
+	std::shared_ptr<SDL_Texture> AssetCache::LoadTexture( SDL_Renderer* renderer, const std::string& path )
+	{
+		if ( auto texture = Find<SDL_Texture>( path ) )
+		{
+			return texture;
+		}
+
+		return AddTexture( renderer, path, DecodeImage( path ) );
+	}
+
+	SDL_Surface* AssetCache::DecodeImage( const std::string& path ) const
+	{
+		SDL_RWops* file = OpenFile( path );
+		SDL_Surface* loadedSurface = file != nullptr ? IMG_Load_RW( file, 1 ) : nullptr;
+		if ( loadedSurface == nullptr )
+		{
+			printf( "Unable to load image %s! Error: %s\n", path.c_str(), IMG_GetError() );
+			return nullptr;
+		}
+
+		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0, 0 ) );
+		return loadedSurface;
+	}
+
+	std::shared_ptr<SDL_Texture> AssetCache::AddTexture( SDL_Renderer* renderer, const std::string& path, SDL_Surface* surface )
+	{
+		if ( surface == nullptr )
+		{
+			return nullptr;
+		}
+
+		SDL_Texture* texture = SDL_CreateTextureFromSurface( renderer, surface );
+		SDL_FreeSurface( surface );
+		if ( texture == nullptr )
+		{
+			printf( "Failed to create texture from %s! Error: %s\n", path.c_str(), SDL_GetError() );
+			return nullptr;
+		}
+
+		Uint32 format;
+		int width, height;
+		SDL_QueryTexture( texture, &format, nullptr, &width, &height );
+		std::size_t bytes = static_cast< std::size_t >( width ) * height * SDL_BYTESPERPIXEL( format );
+
+		return Insert( path, std::shared_ptr<SDL_Texture>( texture, SDL_DestroyTexture ), bytes );
+	}
+
+	void AssetCache::Trim()
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		for ( auto it = mAssets.begin(); it != mAssets.end(); )
+		{
+			if ( it->second.mAsset.use_count() == 1 )
+			{
+				mResidentBytes -= it->second.mBytes;
+				it = mAssets.erase( it );
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void AssetCache::Clean()
+	{
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			mAssets.clear();
+			mResidentBytes = 0;
+		}
+
+		// Fonts read from the mapping until they are closed, so the archive goes last
+		mArchive.Close();
+	}
+}
@@ -0,0 +1,189 @@
+/**
+ * @class AssetCache
+ * @brief Singleton, reference-counted cache of the game's sounds, fonts and textures, keyed by path.
+ *
+ * An asset is loaded from disk the first time it is requested, and every later request for the
+ * same path returns the same shared instance. The cache keeps its own reference, so an asset stays
+ * resident (and is never reloaded) until Trim() or Clean() drops it. Hits, misses and the resident
+ * size are counted to check that nothing is loaded twice.
+ *
+ * When an archive is mounted, assets are read from its memory mapping, and only the ones
+ * missing from it fall back to the loose files.
+ *
+ * Sounds, fonts and DecodeImage() can be loaded from any thread (font opens are serialized,
+ * FreeType isn't thread safe). Creating textures must stay on the rendering thread.
+ *
+ * Example usage:
+ * @code
+ * auto assets = venture::AssetCache::get();
+ * std::shared_ptr<Mix_Chunk> laser = assets->LoadSound( path );
+ * Mix_PlayChannel( -1, laser.get(), 0 );
+ * printf( "%d hits, %d misses, %zu bytes\n", assets->GetHitCount(), assets->GetMissCount(), assets->GetResidentBytes() );
+ * @endcode
+ *
+ * @note Call Clean() before Mix_CloseAudio(), TTF_Quit() and before the renderer is destroyed.
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "AssetArchive.hpp"
+
+namespace venture
+{
+	class AssetCache
+	{
+	public:
+		/**
+		 * @brief Retrieves the static instance of the class, creating one if it doesn't exist.
+		 */
+		static AssetCache* get()
+		{
+			if ( s_Instance == nullptr )
+			{
+				s_Instance = new AssetCache();
+			}
+			return s_Instance;
+		}
+
+		/// Loading
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Maps a packed asset archive, later loads read from it before trying the loose files.
+		 * @param archivePath The archive file.
+		 * @param assetRoot The loose assets folder the archive was packed from.
+		 * @return true if the archive was mounted, false if the loose files will be used.
+		 */
+		bool MountArchive( const std::string& archivePath, const std::string& assetRoot );
+
+		/**
+		 * @brief Returns the sound at path, loading it on the first request.
+		 * @return The shared sound, null if it couldn't be loaded.
+		 */
+		std::shared_ptr<Mix_Chunk> LoadSound( const std::string& path );
+
+		/**
+		 * @brief Returns the font at path and point size, opening it on the first request.
+		 * @return The shared font, null if it couldn't be opened.
+		 */
+		std::shared_ptr<TTF_Font> LoadFont( const std::string& path, int size );
+
+		/**
+		 * @brief Returns the image at path as a texture (black is color keyed), loading it on the first request.
+		 * @return The shared texture, null if it couldn't be loaded.
+		 */
+		std::shared_ptr<SDL_Texture> LoadTexture( SDL_Renderer* renderer, const std::string& path );
+
+		/**
+		 * @brief Decodes the image at path into a color keyed surface, the CPU half of LoadTexture() (any thread).
+		 * @return The surface (to be passed to AddTexture()), null if it couldn't be loaded.
+		 */
+		SDL_Surface* DecodeImage( const std::string& path ) const;
+
+		/**
+		 * @brief Uploads a decoded image and caches it as the texture at path, the GPU half of LoadTexture().
+		 * @param renderer The renderer that owns the texture.
+		 * @param path The image's path (the cache key).
+		 * @param surface The decoded image, freed by this call.
+		 * @return The shared texture, null if it couldn't be created.
+		 */
+		std::shared_ptr<SDL_Texture> AddTexture( SDL_Renderer* renderer, const std::string& path, SDL_Surface* surface );
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Releases the assets nobody but the cache references anymore.
+		 */
+		void Trim();
+
+		/**
+		 * @brief Releases the cache's reference to every asset, and unmounts the archive.
+		 */
+		void Clean();
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the number of requests served from the cache.
+		 */
+		int GetHitCount() const { std::lock_guard<std::mutex> lock( mMutex ); return mHitCount; }
+
+		/**
+		 * @brief Returns the number of requests that loaded an asset.
+		 */
+		int GetMissCount() const { std::lock_guard<std::mutex> lock( mMutex ); return mMissCount; }
+
+		/**
+		 * @brief Returns the approximate memory held by the cached assets, in bytes.
+		 */
+		std::size_t GetResidentBytes() const { std::lock_guard<std::mutex> lock( mMutex ); return mResidentBytes; }
+
+		/**
+		 * @brief Returns the number of cached assets.
+		 */
+		std::size_t GetAssetCount() const { std::lock_guard<std::mutex> lock( mMutex ); return mAssets.size(); }
+
+	private:
+		// A cached asset, type erased
+		struct Entry
+		{
+			std::shared_ptr<void> mAsset;
+			std::size_t mBytes;
+		};
+
+		// Private constructor to follow the singleton design pattern.
+		AssetCache() = default;
+
+		/**
+		 * @brief Opens an asset from the archive, or from the loose file if it isn't packed.
+		 */
+		SDL_RWops* OpenFile( const std::string& path ) const;
+
+		/**
+		 * @brief Returns the cached asset for key (counting a hit), or null (counting a miss).
+		 */
+		template<typename T>
+		std::shared_ptr<T> Find( const std::string& key );
+
+		/**
+		 * @brief Adds a freshly loaded asset to the cache (if another thread cached it meanwhile, that one is kept).
+		 */
+		template<typename T>
+		std::shared_ptr<T> Insert( const std::string& key, std::shared_ptr<T> asset, std::size_t bytes );
+
+		// The static instance of the class (to follow the singleton design pattern)
+		static AssetCache* s_Instance;
+
+		// The mounted archive (if any)
+		AssetArchive mArchive;
+
+		// The cached assets, keyed by path (and size for fonts)
+		std::unordered_map<std::string, Entry> mAssets;
+		// Guards mAssets and the statistics
+		mutable std::mutex mMutex;
+		// Serializes the font opens
+		std::mutex mFontMutex;
+
+		// Cache statistics
+		int mHitCount = 0;
+		int mMissCount = 0;
+		std::size_t mResidentBytes = 0;
+
+		// Deleted constructors and assignment operators for Singleton enforcement.
+		AssetCache( AssetCache&& ) = delete;
+		AssetCache( const AssetCache& ) = delete;
+		AssetCache& operator=( AssetCache&& ) = delete;
+		AssetCache& operator=( const AssetCache& ) = delete;
+	};
+}
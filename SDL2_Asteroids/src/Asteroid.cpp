@@ -3,11 +3,10 @@
 
 #include <random>
 
-Asteroid::Asteroid( const SpaceObject& obj, const SDL_Color& color )
+Asteroid::Asteroid( const SpaceObject& obj, const SDL_Color& color, std::mt19937& rng )
 	: mAsteroid(obj), mColor(color)
 {
-	static std::mt19937 rng( std::random_device{}( ) );
-	static std::uniform_real_distribution<float> asteroidVertsDist( 0.8f, 1.2f );
+	std::uniform_int_distribution<int> shapeDist( 0, SHAPE_COUNT - 1 );
 
 	mAsteroid.mSize = obj.mSize;
 	mAsteroid.mPosition.x = obj.mPosition.x;
@@ -15,18 +14,11 @@ Asteroid::Asteroid( const SpaceObject& obj, const SDL_Color& color )
 	mAsteroid.mVelocity.x = obj.mVelocity.x;
 	mAsteroid.mVelocity.y = obj.mVelocity.y;
 
-	int verts = 20;
-	for ( int i = 0; i < verts; i++ )
-	{
-		float noise = asteroidVertsDist( rng );
-		vecModelAsteroid.emplace_back( noise * sinf( ( ( float ) i / ( float ) verts ) * 6.28318f ),
-									   noise * cosf( ( ( float ) i / ( float ) verts ) * 6.28318f ) );
-	}
-	
+	mShapeId = shapeDist( rng );
 }
 
 Asteroid::Asteroid( const Asteroid& other )
-	: vecModelAsteroid(other.vecModelAsteroid) ,mColor(other.mColor)
+	: mShapeId(other.mShapeId) ,mColor(other.mColor)
 {	
 	mAsteroid.mPosition = other.mAsteroid.mPosition;
 	mAsteroid.mVelocity = other.mAsteroid.mVelocity;
@@ -39,7 +31,7 @@ Asteroid Asteroid::operator=( const Asteroid& other )
 {
 	if ( &other != this )
 	{
-		vecModelAsteroid = other.vecModelAsteroid;
+		mShapeId = other.mShapeId;
 		mColor = other.mColor;
 		mAsteroid.mPosition = other.mAsteroid.mPosition;
 		mAsteroid.mVelocity = other.mAsteroid.mVelocity;
@@ -57,46 +49,36 @@ Asteroid::~Asteroid()
 
 void Asteroid::Update( float deltaTime )
 {
-	// Move and Rotate Asteroids
-	mAsteroid.mPosition.x += mAsteroid.mVelocity.x * deltaTime;
-	mAsteroid.mPosition.y += mAsteroid.mVelocity.y * deltaTime;
+	// Rotate Asteroids, movement and screen wrapping are done by the kinematics kernel (see Game::Update)
 	mAsteroid.mRotation += 0.7f * deltaTime;
-	
-	auto fSize = static_cast< float >( GetSize() );
-
-	// Screen Wrapping Adjustment 
-	if ( mAsteroid.mPosition.x > SCREEN_WIDTH + fSize )
-	{
-		mAsteroid.mPosition.x = -fSize;
-	}
-	else if ( mAsteroid.mPosition.x < -fSize )
-	{
-		mAsteroid.mPosition.x = SCREEN_WIDTH + fSize;
-	}
-
-	if ( mAsteroid.mPosition.y > SCREEN_HEIGHT + fSize )
-	{
-		mAsteroid.mPosition.y = -fSize;
-	}
-	else if ( mAsteroid.mPosition.y < -fSize )
-	{
-		mAsteroid.mPosition.y = SCREEN_HEIGHT + fSize;
-	}
-
 }
 
-void Asteroid::Render( SDL_Renderer* renderer )
+void Asteroid::Clean()
 {
-	auto game = Game::GetInstance();
-
-	SDL_SetRenderDrawColor( renderer, mColor.r, mColor.g, mColor.b, mColor.a );
-
- 	game->DrawWireFrameModel( renderer, vecModelAsteroid,
- 												 mAsteroid.mPosition.x, mAsteroid.mPosition.y, 
- 												 mAsteroid.mRotation, static_cast<float>( mAsteroid.mSize ) );
+	// Nothing to release, the shapes are shared between all the asteroids
 }
 
-void Asteroid::Clean()
+const vector<pair<float, float>>& Asteroid::GetShape( int shapeId )
 {
-	vecModelAsteroid.clear();
+	// Generated on first use (thread safe), a jagged circle per shape, from a fixed seed so every run has the same shapes
+	static const vector<vector<pair<float, float>>> shapes = []()
+		{
+			std::mt19937 rng( SHAPE_SEED );
+			std::uniform_real_distribution<float> asteroidVertsDist( 0.8f, 1.2f );
+
+			vector<vector<pair<float, float>>> result( SHAPE_COUNT );
+			int verts = 20;
+			for ( auto& shape : result )
+			{
+				for ( int i = 0; i < verts; i++ )
+				{
+					float noise = asteroidVertsDist( rng );
+					shape.emplace_back( noise * sinf( ( ( float ) i / ( float ) verts ) * 6.28318f ),
+										noise * cosf( ( ( float ) i / ( float ) verts ) * 6.28318f ) );
+				}
+			}
+			return result;
+		}();
+
+	return shapes[ shapeId ];
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <random>
 #include <vector>
 #include <utility>
 
@@ -20,8 +21,9 @@ public:
 	* @brief Constructor for Asteroid class.
 	* @param obj SpaceObject representing the asteroid.
 	* @param color Color of the asteroid.
+	* @param rng Picks the asteroid's shape (the game's seeded generator, so a scenario's seed reproduces the field).
 	*/
-	Asteroid( const SpaceObject& obj, const SDL_Color& color );
+	Asteroid( const SpaceObject& obj, const SDL_Color& color, std::mt19937& rng );
 
 	/**
 	 * @brief Copy constructor for the Asteroid class.
@@ -45,17 +47,12 @@ public:
 	///--------------------------------------------------------
 	
 	/**
-	 * @brief Updates the asteroid's state.
+	 * @brief Updates the asteroid's rotation.
+	 * The asteroid's position is integrated and wrapped in batch by the game (see Kinematics.h).
 	 * @param deltaTime Time elapsed since the last update.
 	 */
 	void Update( float deltaTime );
 
-	/**
-	 * @brief Renders the asteroid on the given renderer.
-	 * @param renderer SDL Renderer to draw the asteroid.
-	 */
-	void Render( SDL_Renderer* renderer );
-
 	/**
 	 * @brief Performs cleanup of the asteroid's resources.
 	 */
@@ -93,6 +90,26 @@ public:
 	 * @return Reference to the asteroid's SpaceObject.
 	 */
 	SpaceObject& GetSpaceObject() { return mAsteroid; }
+	const SpaceObject& GetSpaceObject() const { return mAsteroid; }
+
+	/**
+	 * @brief Retrieves the asteroid's model coordinates.
+	 * @return The asteroid's wire frame vertices (before being transformed).
+	 */
+	const vector<pair<float, float>>& GetModel() const noexcept { return GetShape( mShapeId ); }
+
+	/**
+	 * @brief Retrieves the index of the asteroid's shape.
+	 */
+	int GetShapeId() const noexcept { return mShapeId; }
+
+	/**
+	 * @brief Retrieves one of the shared asteroid shapes.
+	 * The shapes are generated once, and never change, so they can be read from any thread.
+	 * @param shapeId The shape's index, in [0, SHAPE_COUNT).
+	 * @return The shape's wire frame vertices.
+	 */
+	static const vector<pair<float, float>>& GetShape( int shapeId );
 
 	/**
 	 * @brief Retrieves the color of the asteroid.
@@ -102,8 +119,8 @@ public:
 
 private:
 
-	// Model coordinates for the asteroid.
-	vector<pair<float, float>> vecModelAsteroid;
+	// Index of the asteroid's shape (its model coordinates).
+	int mShapeId;
 	// SpaceObject representing the asteroid.
 	SpaceObject mAsteroid;
 	
@@ -114,6 +131,10 @@ private:
 	static const int MIN_SIZE = 48;
 	// Maximum size of the asteroid.
 	static const int MAX_SIZE = 96;
+	// Number of different asteroid shapes.
+	static const int SHAPE_COUNT = 32;
+	// Seed of the shapes, the same on every run.
+	static const unsigned SHAPE_SEED = 0x5EED;
 
 };
 
@@ -0,0 +1,156 @@
+#include "AsyncLoader.hpp"
+#include "AssetCache.hpp"
+#include "FontManager.hpp"
+
+namespace venture
+{
+	AsyncLoader::AsyncLoader( JobSystem& jobs )
+		: mJobs( jobs )
+	{
+		mReadyFuture = mReady.get_future().share();
+	}
+
+	AsyncLoader::~AsyncLoader()
+	{
+		for ( const JobHandle& job : mJobHandles )
+		{
+			mJobs.Wait( job );
+		}
+
+		// Drop the images that never made it to the main thread
+		for ( Request& request : mRequests )
+		{
+			SDL_FreeSurface( request.mSurface );
+			request.mSurface = nullptr;
+		}
+	}
+
+	void AsyncLoader::QueueSound( const std::string& path )
+	{
+		mRequests.push_back( { AssetType::Sound, path, 0, nullptr } );
+	}
+
+	void AsyncLoader::QueueFont( const std::string& path, int size )
+	{
+		mRequests.push_back( { AssetType::Font, path, size, nullptr } );
+	}
+
+	void AsyncLoader::QueueTexture( const std::string& path )
+	{
+		mRequests.push_back( { AssetType::Texture, path, 0, nullptr } );
+	}
+
+	std::shared_future<void> AsyncLoader::Start()
+	{
+		if ( mStarted )
+		{
+			return mReadyFuture;
+		}
+		mStarted = true;
+
+		if ( mRequests.empty() )
+		{
+			mReady.set_value();
+			return mReadyFuture;
+		}
+
+		if ( mJobs.GetWorkerCount() == 0 )
+		{
+			// Nobody to decode in the background, load everything right away
+			for ( std::size_t i = 0; i < mRequests.size(); ++i )
+			{
+				Decode( i );
+			}
+			return mReadyFuture;
+		}
+
+		mJobHandles.reserve( mRequests.size() );
+		for ( std::size_t i = 0; i < mRequests.size(); ++i )
+		{
+			mJobHandles.push_back( mJobs.Schedule( [ this, i ]() { Decode( i ); } ) );
+		}
+		return mReadyFuture;
+	}
+
+	void AsyncLoader::Decode( std::size_t index )
+	{
+		Request& request = mRequests[ index ];
+		auto assets = AssetCache::get();
+		switch ( request.mType )
+		{
+		case AssetType::Sound:
+			assets->LoadSound( request.mPath );
+			break;
+		case AssetType::Font:
+			assets->LoadFont( request.mPath, request.mFontSize );
+			break;
+		case AssetType::Texture:
+			request.mSurface = assets->DecodeImage( request.mPath );
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock( mDecodedMutex );
+			mDecoded.push_back( index );
+		}
+		++mDecodedCount;
+	}
+
+	void AsyncLoader::Update( SDL_Renderer* renderer )
+	{
+		if ( !mStarted || IsDone() )
+		{
+			return;
+		}
+
+		std::vector<std::size_t> decoded;
+		{
+			std::lock_guard<std::mutex> lock( mDecodedMutex );
+			decoded.swap( mDecoded );
+		}
+
+		for ( std::size_t index : decoded )
+		{
+			Request& request = mRequests[ index ];
+			switch ( request.mType )
+			{
+			case AssetType::Sound:
+				++mFinishedCount;
+				break;
+			case AssetType::Font:
+				mPendingFonts.push_back( index );
+				break;
+			case AssetType::Texture:
+				AssetCache::get()->AddTexture( renderer, request.mPath, request.mSurface );
+				request.mSurface = nullptr;
+				++mFinishedCount;
+				break;
+			}
+		}
+
+		// Rasterizing glyphs uses FreeType too, so it waits until no worker is opening a font
+		if ( !mPendingFonts.empty() && mDecodedCount == static_cast< int >( mRequests.size() ) )
+		{
+			for ( std::size_t index : mPendingFonts )
+			{
+				FontManager::get()->GetGlyphAtlas( renderer, mRequests[ index ].mPath, mRequests[ index ].mFontSize );
+				++mFinishedCount;
+			}
+			mPendingFonts.clear();
+		}
+
+		if ( IsDone() )
+		{
+			mReady.set_value();
+		}
+	}
+
+	float AsyncLoader::GetProgress() const
+	{
+		if ( mRequests.empty() )
+		{
+			return 1.f;
+		}
+		return static_cast< float >( mFinishedCount ) / static_cast< float >( mRequests.size() );
+	}
+}
@@ -0,0 +1,149 @@
+/**
+ * @class AsyncLoader
+ * @brief Loads a batch of assets in the background, on the JobSystem workers.
+ *
+ * Sounds, fonts and images are decoded on worker threads into the AssetCache. The steps that
+ * need the renderer (texture uploads, glyph atlases) are handed back to the main thread, which
+ * runs them from Update() once per frame. Progress can be polled, or waited on through a future,
+ * so the window can show a loading screen right away instead of blocking before the first frame.
+ *
+ * Example usage:
+ * @code
+ * venture::AsyncLoader loader( jobs );
+ * loader.QueueSound( laserPath );
+ * loader.QueueFont( fontPath, 20 );
+ * loader.Start();
+ * while ( !loader.IsDone() )
+ * {
+ *     loader.Update( renderer ); // Main thread: finishes the decoded assets
+ *     DrawLoadingBar( loader.GetProgress() );
+ * }
+ * @endcode
+ */
+
+#pragma once
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "JobSystem.hpp"
+
+namespace venture
+{
+	class AsyncLoader
+	{
+	public:
+
+		/// Constructors & Destructors
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Constructor for the AsyncLoader class.
+		 * @param jobs The job system the assets are decoded on.
+		 */
+		explicit AsyncLoader( JobSystem& jobs );
+
+		/**
+		 * @brief Destructor for the AsyncLoader class, waits for the decoding jobs still running.
+		 */
+		~AsyncLoader();
+
+		/// Queueing (before Start)
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Queues a sound.
+		 */
+		void QueueSound( const std::string& path );
+
+		/**
+		 * @brief Queues a font, its glyph atlas is rasterized on the main thread once the fonts are open.
+		 */
+		void QueueFont( const std::string& path, int size );
+
+		/**
+		 * @brief Queues an image, decoded in the background and uploaded as a texture on the main thread.
+		 */
+		void QueueTexture( const std::string& path );
+
+		/// Loading
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Starts decoding every queued asset.
+		 * @return A future that is ready once every asset is loaded and finished (after the last Update()).
+		 */
+		std::shared_future<void> Start();
+
+		/**
+		 * @brief Runs the main thread steps of the assets decoded so far, call it once per frame.
+		 * @param renderer The renderer that owns the textures.
+		 */
+		void Update( SDL_Renderer* renderer );
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the fraction of the queued assets that are completely loaded, in [0, 1].
+		 */
+		float GetProgress() const;
+
+		/**
+		 * @brief Checks if every queued asset is loaded.
+		 */
+		bool IsDone() const { return mFinishedCount == static_cast< int >( mRequests.size() ); }
+
+	private:
+		// The kind of asset requested
+		enum class AssetType
+		{
+			Sound,
+			Font,
+			Texture,
+		};
+
+		// A queued asset
+		struct Request
+		{
+			AssetType mType;
+			std::string mPath;
+			int mFontSize;
+			// The decoded image, until the main thread uploads it
+			SDL_Surface* mSurface;
+		};
+
+		/**
+		 * @brief Decodes a request (worker thread).
+		 */
+		void Decode( std::size_t index );
+
+	private:
+		// The job system the assets are decoded on
+		JobSystem& mJobs;
+		// The queued assets
+		std::vector<Request> mRequests;
+		// The decoding jobs
+		std::vector<JobHandle> mJobHandles;
+
+		// Requests decoded by the workers, waiting for the main thread
+		std::mutex mDecodedMutex;
+		std::vector<std::size_t> mDecoded;
+		// Number of requests the workers are done with
+		std::atomic<int> mDecodedCount{ 0 };
+		// Number of requests completely loaded
+		int mFinishedCount = 0;
+		// Font requests decoded, waiting for every worker to be done to rasterize their atlases
+		std::vector<std::size_t> mPendingFonts;
+
+		// Set once everything is loaded
+		std::promise<void> mReady;
+		std::shared_future<void> mReadyFuture;
+		bool mStarted = false;
+	};
+}
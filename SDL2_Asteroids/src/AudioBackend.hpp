@@ -0,0 +1,88 @@
+/**
+ * @class IAudioBackend
+ * @brief The interface the game plays its sounds through.
+ *
+ * Sounds are loaded once and referred to by a SoundHandle afterwards, voices play on numbered
+ * channels. SdlMixerAudioBackend plays them with SDL_mixer, NullAudioBackend only records the
+ * calls (for headless runs, machines without a sound device, and assertions).
+ *
+ * Example usage:
+ * @code
+ * std::unique_ptr<venture::IAudioBackend> audio = std::make_unique<venture::NullAudioBackend>();
+ * venture::SoundHandle laser = audio->LoadSound( laserPath, MIX_MAX_VOLUME / 7 );
+ * audio->AllocateChannels( 16 );
+ * audio->Play( 0, laser, 0, 1.f );
+ * @endcode
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace venture
+{
+	// Refers to a sound loaded by an audio backend
+	using SoundHandle = int;
+
+	// A handle that refers to no sound
+	const SoundHandle INVALID_SOUND = -1;
+
+	class IAudioBackend
+	{
+	public:
+		virtual ~IAudioBackend() = default;
+
+		/**
+		 * @brief Returns a printable name of the backend.
+		 */
+		virtual const char* GetName() const = 0;
+
+		/**
+		 * @brief Checks if the backend decodes the sounds it loads (worth preloading them).
+		 */
+		virtual bool DecodesSounds() const = 0;
+
+		/**
+		 * @brief Loads a sound (loading the same path again returns the same handle).
+		 * @param path The sound file.
+		 * @param volume The sound's own volume (0 - MIX_MAX_VOLUME).
+		 * @return The sound's handle, INVALID_SOUND if it couldn't be loaded.
+		 */
+		virtual SoundHandle LoadSound( const std::string& path, int volume ) = 0;
+
+		/**
+		 * @brief Allocates the voice channels.
+		 * @return The number of channels allocated.
+		 */
+		virtual int AllocateChannels( int count ) = 0;
+
+		/**
+		 * @brief Plays a sound on a channel, replacing what the channel was playing.
+		 * @param channel The channel.
+		 * @param sound The sound.
+		 * @param loops Number of extra repetitions, -1 loops forever.
+		 * @param gain Scales the sound's own volume (1 plays it as loaded, louder is capped at MIX_MAX_VOLUME).
+		 * The channel itself plays at full volume.
+		 */
+		virtual void Play( int channel, SoundHandle sound, int loops, float gain ) = 0;
+
+		/**
+		 * @brief Sets a channel's stereo panning and distance attenuation (255, 255, 0 restores a centered, full volume voice).
+		 * @param channel The channel.
+		 * @param left The left speaker volume (0 - 255).
+		 * @param right The right speaker volume (0 - 255).
+		 * @param distance The distance to the listener (0 is the closest, 255 the farthest).
+		 */
+		virtual void SetPosition( int channel, uint8_t left, uint8_t right, uint8_t distance ) = 0;
+
+		/**
+		 * @brief Stops a channel, -1 stops every channel.
+		 */
+		virtual void Halt( int channel ) = 0;
+
+		/**
+		 * @brief Checks if a channel is playing.
+		 */
+		virtual bool IsPlaying( int channel ) const = 0;
+	};
+}
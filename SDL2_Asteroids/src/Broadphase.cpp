@@ -0,0 +1,154 @@
+#include "Broadphase.h"
+#include "Game.h"
+
+#include <algorithm>
+
+const int Broadphase::COLUMNS = SCREEN_WIDTH / CELL_SIZE + 1;
+const int Broadphase::ROWS = SCREEN_HEIGHT / CELL_SIZE + 1;
+
+void Broadphase::Build( const KinematicsBatch& objects )
+{
+	Build( objects, nullptr, objects.Size() );
+}
+
+void Broadphase::Build( const KinematicsBatch& objects, venture::JobSystem& jobs, std::size_t grainSize )
+{
+	Build( objects, &jobs, grainSize );
+}
+
+void Broadphase::Build( const KinematicsBatch& objects, venture::JobSystem* jobs, std::size_t grainSize )
+{
+	const std::size_t count = objects.Size();
+	const std::size_t cells = static_cast< std::size_t >( COLUMNS * ROWS );
+	grainSize = std::max<std::size_t>( grainSize, 1 );
+	const std::size_t ranges = std::max<std::size_t>( ( count + grainSize - 1 ) / grainSize, 1 );
+
+	mPositionsX.resize( count );
+	mPositionsY.resize( count );
+	mRadii.resize( count );
+	mRangeCells.assign( ranges * cells, 0 );
+
+	auto run = [ jobs, count, grainSize ]( const venture::RangeFunction& function )
+		{
+			if ( jobs )
+			{
+				jobs->ParallelFor( count, grainSize, function );
+			}
+			else
+			{
+				function( 0, count );
+			}
+		};
+
+	// Count the objects in every cell their bounding box overlaps, per range
+	run( [ this, &objects, grainSize, cells ]( std::size_t begin, std::size_t end )
+		{
+			CountRange( objects, begin, end, &mRangeCells[ begin / grainSize * cells ] );
+		} );
+
+	// Prefix sum over the cells, then the ranges in order: mCellStart[cell] becomes the first slot of the cell,
+	// and a range's count of a cell becomes the range's first slot in it
+	mCellStart.resize( cells + 1 );
+	int slot = 0;
+	for ( std::size_t cell = 0; cell < cells; ++cell )
+	{
+		mCellStart[ cell ] = slot;
+		for ( std::size_t range = 0; range < ranges; ++range )
+		{
+			int rangeCount = mRangeCells[ range * cells + cell ];
+			mRangeCells[ range * cells + cell ] = slot;
+			slot += rangeCount;
+		}
+	}
+	mCellStart[ cells ] = slot;
+
+	// Fill the cells, every range in ascending object index order after the ranges before it
+	mCellItems.resize( slot );
+	run( [ this, grainSize, cells ]( std::size_t begin, std::size_t end )
+		{
+			FillRange( begin, end, &mRangeCells[ begin / grainSize * cells ] );
+		} );
+}
+
+void Broadphase::CountRange( const KinematicsBatch& objects, std::size_t begin, std::size_t end, int* counts )
+{
+	std::copy( objects.mPositionsX.begin() + begin, objects.mPositionsX.begin() + end, mPositionsX.begin() + begin );
+	std::copy( objects.mPositionsY.begin() + begin, objects.mPositionsY.begin() + end, mPositionsY.begin() + begin );
+	std::copy( objects.mSizes.begin() + begin, objects.mSizes.begin() + end, mRadii.begin() + begin );
+
+	for ( std::size_t i = begin; i < end; ++i )
+	{
+		int minColumn = GetColumn( mPositionsX[ i ] - mRadii[ i ] );
+		int maxColumn = GetColumn( mPositionsX[ i ] + mRadii[ i ] );
+		int minRow = GetRow( mPositionsY[ i ] - mRadii[ i ] );
+		int maxRow = GetRow( mPositionsY[ i ] + mRadii[ i ] );
+
+		for ( int row = minRow; row <= maxRow; ++row )
+		{
+			for ( int column = minColumn; column <= maxColumn; ++column )
+			{
+				++counts[ row * COLUMNS + column ];
+			}
+		}
+	}
+}
+
+void Broadphase::FillRange( std::size_t begin, std::size_t end, int* cursors )
+{
+	for ( std::size_t i = begin; i < end; ++i )
+	{
+		int minColumn = GetColumn( mPositionsX[ i ] - mRadii[ i ] );
+		int maxColumn = GetColumn( mPositionsX[ i ] + mRadii[ i ] );
+		int minRow = GetRow( mPositionsY[ i ] - mRadii[ i ] );
+		int maxRow = GetRow( mPositionsY[ i ] + mRadii[ i ] );
+
+		for ( int row = minRow; row <= maxRow; ++row )
+		{
+			for ( int column = minColumn; column <= maxColumn; ++column )
+			{
+				mCellItems[ cursors[ row * COLUMNS + column ]++ ] = static_cast< int >( i );
+			}
+		}
+	}
+}
+
+int Broadphase::FindFirstHit( float x, float y, int* pairsTested ) const
+{
+	if ( mCellStart.empty() )
+	{
+		return -1;
+	}
+
+	int cell = GetRow( y ) * COLUMNS + GetColumn( x );
+
+	for ( int item = mCellStart[ cell ]; item < mCellStart[ cell + 1 ]; ++item )
+	{
+		int i = mCellItems[ item ];
+		float dx = x - mPositionsX[ i ];
+		float dy = y - mPositionsY[ i ];
+		if ( dx * dx + dy * dy < mRadii[ i ] * mRadii[ i ] )
+		{
+			if ( pairsTested )
+			{
+				*pairsTested += item - mCellStart[ cell ] + 1;
+			}
+			// Items are sorted by index, the first hit is the lowest index
+			return i;
+		}
+	}
+	if ( pairsTested )
+	{
+		*pairsTested += mCellStart[ cell + 1 ] - mCellStart[ cell ];
+	}
+	return -1;
+}
+
+int Broadphase::GetColumn( float x ) const
+{
+	return std::clamp( static_cast< int >( x ) / CELL_SIZE, 0, COLUMNS - 1 );
+}
+
+int Broadphase::GetRow( float y ) const
+{
+	return std::clamp( static_cast< int >( y ) / CELL_SIZE, 0, ROWS - 1 );
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "JobSystem.hpp"
+#include "Kinematics.h"
+
+// A uniform grid over the screen used to find which asteroids a point may be inside of,
+// without testing the point against every asteroid.
+// The grid keeps its own copy of the positions and sizes it was built from, so the asteroids
+// can keep moving (on another thread) while bullets are tested against the grid.
+// The build can be split across the job system: every range of objects counts its items per cell,
+// a prefix sum over the cells (then the ranges, in order) gives every range its slots, and every
+// range scatters its items into them, so the cells stay sorted by object index.
+
+class Broadphase
+{
+public:
+
+	/// Utility
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Rebuilds the grid from a batch of circles (positions as centers, sizes as radii).
+	 * @param objects The objects to insert, their indices are the ones returned by the queries.
+	 */
+	void Build( const KinematicsBatch& objects );
+
+	/**
+	 * @brief Rebuilds the grid like above, counting and scattering ranges of objects on the job system's threads.
+	 * @param jobs Runs the ranges, waited for before returning (may be called from inside a job).
+	 * @param grainSize Number of objects per range.
+	 */
+	void Build( const KinematicsBatch& objects, venture::JobSystem& jobs, std::size_t grainSize );
+
+	/**
+	 * @brief Finds the lowest index object whose circle contains a point.
+	 * @param x The point's x position
+	 * @param y The point's y position
+	 * @param pairsTested Optional, incremented by the number of objects the point was tested against.
+	 * @return The object's index, or -1 if the point isn't inside any object.
+	 */
+	int FindFirstHit( float x, float y, int* pairsTested = nullptr ) const;
+
+	/**
+	 * @brief Returns the number of objects the grid was built from.
+	 */
+	std::size_t Size() const { return mPositionsX.size(); }
+
+private:
+	/**
+	 * @brief Rebuilds the grid, running the ranges with the job system if there's one, inline otherwise.
+	 */
+	void Build( const KinematicsBatch& objects, venture::JobSystem* jobs, std::size_t grainSize );
+
+	/**
+	 * @brief Copies a range of objects into the snapshot and counts their items per cell.
+	 * @param counts The range's count of every cell
+	 */
+	void CountRange( const KinematicsBatch& objects, std::size_t begin, std::size_t end, int* counts );
+
+	/**
+	 * @brief Writes a range of objects' items into the cells.
+	 * @param cursors The range's next slot in every cell
+	 */
+	void FillRange( std::size_t begin, std::size_t end, int* cursors );
+
+	/**
+	 * @brief Returns the column of an x position, clamped to the grid.
+	 */
+	int GetColumn( float x ) const;
+
+	/**
+	 * @brief Returns the row of a y position, clamped to the grid.
+	 */
+	int GetRow( float y ) const;
+
+private:
+	// Snapshot of the objects x positions
+	std::vector<float> mPositionsX;
+	// Snapshot of the objects y positions
+	std::vector<float> mPositionsY;
+	// Snapshot of the objects radii
+	std::vector<float> mRadii;
+
+	// Index of the first item of every cell in mCellItems (one extra entry marks the end)
+	std::vector<int> mCellStart;
+	// The objects indices, grouped by cell and sorted by index inside a cell
+	std::vector<int> mCellItems;
+	// Every range's item count per cell while building, then its first slot per cell (range major)
+	std::vector<int> mRangeCells;
+
+	// Cell size, in pixels
+	static const int CELL_SIZE = 64;
+	// Grid width in cells
+	static const int COLUMNS;
+	// Grid height in cells
+	static const int ROWS;
+};
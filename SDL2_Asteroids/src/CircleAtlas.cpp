@@ -0,0 +1,156 @@
+#include "CircleAtlas.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace venture
+{
+	bool CircleAtlas::Create( SDL_Renderer* renderer, int size )
+	{
+		Clean();
+
+		mTexture.reset( SDL_CreateTexture( renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, size, size ) );
+		if ( mTexture == nullptr )
+		{
+			printf( "Failed to create the circle atlas texture! Error: %s\n", SDL_GetError() );
+			return false;
+		}
+		SDL_SetTextureBlendMode( mTexture.get(), SDL_BLENDMODE_BLEND );
+
+		// Start fully transparent
+		std::vector<uint8_t> clear( static_cast< std::size_t >( size ) * size * 4, 0 );
+		SDL_UpdateTexture( mTexture.get(), nullptr, clear.data(), size * 4 );
+
+		mSize = size;
+		return true;
+	}
+
+	void CircleAtlas::Clean()
+	{
+		mTexture.reset();
+		mSprites.clear();
+		mVertices.clear();
+		mIndices.clear();
+		mSize = 0;
+		mShelfY = 0;
+		mShelfHeight = 0;
+		mCursorX = 0;
+	}
+
+	bool CircleAtlas::AddCircle( float centerX, float centerY, float radius, const SDL_Color& color )
+	{
+		const Sprite* sprite = GetSprite( static_cast< int >( std::lround( radius ) ), color );
+		if ( sprite == nullptr )
+		{
+			return false;
+		}
+
+		// The sprite's center pixel lands on the circle's center
+		float half = static_cast< float >( sprite->mSize / 2 );
+		float x0 = centerX - half;
+		float y0 = centerY - half;
+		float x1 = x0 + sprite->mSize;
+		float y1 = y0 + sprite->mSize;
+		const SDL_Color white = { 255, 255, 255, 255 };
+
+		int first = static_cast< int >( mVertices.size() );
+		mVertices.push_back( { { x0, y0 }, white, { sprite->mU0, sprite->mV0 } } );
+		mVertices.push_back( { { x1, y0 }, white, { sprite->mU1, sprite->mV0 } } );
+		mVertices.push_back( { { x0, y1 }, white, { sprite->mU0, sprite->mV1 } } );
+		mVertices.push_back( { { x1, y1 }, white, { sprite->mU1, sprite->mV1 } } );
+
+		mIndices.push_back( first );
+		mIndices.push_back( first + 1 );
+		mIndices.push_back( first + 2 );
+		mIndices.push_back( first + 1 );
+		mIndices.push_back( first + 3 );
+		mIndices.push_back( first + 2 );
+		return true;
+	}
+
+	int CircleAtlas::Flush( SDL_Renderer* renderer )
+	{
+		if ( mIndices.empty() )
+		{
+			return 0;
+		}
+
+		// A failed call isn't counted as a draw call, like LineBatcher's
+		bool drawn = SDL_RenderGeometry( renderer, mTexture.get(), mVertices.data(), static_cast< int >( mVertices.size() ),
+										 mIndices.data(), static_cast< int >( mIndices.size() ) ) == 0;
+		if ( !drawn )
+		{
+			printf( "Failed to draw the circles! Error: %s\n", SDL_GetError() );
+		}
+
+		mVertices.clear();
+		mIndices.clear();
+		return drawn ? 1 : 0;
+	}
+
+	const CircleAtlas::Sprite* CircleAtlas::GetSprite( int radius, const SDL_Color& color )
+	{
+		uint64_t key = ( static_cast< uint64_t >( radius ) << 32 ) |
+			( static_cast< uint64_t >( color.r ) << 24 ) | ( static_cast< uint64_t >( color.g ) << 16 ) |
+			( static_cast< uint64_t >( color.b ) << 8 ) | color.a;
+
+		auto it = mSprites.find( key );
+		if ( it != mSprites.end() )
+		{
+			return &it->second;
+		}
+
+		if ( mTexture == nullptr )
+		{
+			return nullptr;
+		}
+
+		// Find room on the current shelf, or open a new one (1 pixel of padding between sprites)
+		int size = radius * 2 + 1;
+		if ( mCursorX + size > mSize )
+		{
+			mShelfY += mShelfHeight + 1;
+			mShelfHeight = 0;
+			mCursorX = 0;
+		}
+		if ( size > mSize || mShelfY + size > mSize )
+		{
+			printf( "The circle atlas is full, can't add a circle of radius %d!\n", radius );
+			return nullptr;
+		}
+
+		// Rasterize the circle once
+		std::vector<uint8_t> pixels( static_cast< std::size_t >( size ) * size * 4, 0 );
+		for ( int py = 0; py < size; ++py )
+		{
+			for ( int px = 0; px < size; ++px )
+			{
+				int dx = px - radius;
+				int dy = py - radius;
+				if ( dx * dx + dy * dy <= radius * radius )
+				{
+					uint8_t* pixel = &pixels[ ( static_cast< std::size_t >( py ) * size + px ) * 4 ];
+					pixel[ 0 ] = color.r;
+					pixel[ 1 ] = color.g;
+					pixel[ 2 ] = color.b;
+					pixel[ 3 ] = color.a;
+				}
+			}
+		}
+
+		SDL_Rect region = { mCursorX, mShelfY, size, size };
+		SDL_UpdateTexture( mTexture.get(), &region, pixels.data(), size * 4 );
+
+		float atlasSize = static_cast< float >( mSize );
+		Sprite sprite = { region.x / atlasSize, region.y / atlasSize,
+						  ( region.x + size ) / atlasSize, ( region.y + size ) / atlasSize, size };
+
+		mCursorX += size + 1;
+		if ( size > mShelfHeight )
+		{
+			mShelfHeight = size;
+		}
+
+		return &mSprites.emplace( key, sprite ).first->second;
+	}
+}
@@ -0,0 +1,105 @@
+/**
+ * @class CircleAtlas
+ * @brief Draws filled circles from sprites cached in a texture atlas, batched into one draw call.
+ *
+ * The first time a (radius, color) pair is used, the circle is rasterized once into a free spot of
+ * the atlas texture. Every circle queued with AddCircle() afterwards is just a textured quad, and
+ * Flush() draws all of them with a single SDL_RenderGeometry call.
+ *
+ * Example usage:
+ * @code
+ * venture::CircleAtlas atlas;
+ * atlas.Create( renderer );
+ * atlas.AddCircle( x, y, 2.f, SDL_Color( 255, 0, 0, 255 ) );
+ * atlas.Flush( renderer ); // Draws everything added since the last flush
+ * @endcode
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "Texture.hpp"
+
+namespace venture
+{
+	class CircleAtlas
+	{
+	public:
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Creates the (empty) atlas texture.
+		 * @param renderer The renderer that owns the texture.
+		 * @param size The atlas width and height, in pixels.
+		 * @return true on success, false on failure.
+		 */
+		bool Create( SDL_Renderer* renderer, int size = 256 );
+
+		/**
+		 * @brief Releases the atlas texture and forgets every cached sprite.
+		 */
+		void Clean();
+
+		/**
+		 * @brief Queues a filled circle, rasterizing its sprite first if it isn't cached yet.
+		 * @param centerX The circle's center x position
+		 * @param centerY The circle's center y position
+		 * @param radius The circle's radius (rounded to whole pixels)
+		 * @param color The circle's color
+		 * @return false if the sprite doesn't fit in the atlas.
+		 */
+		bool AddCircle( float centerX, float centerY, float radius, const SDL_Color& color );
+
+		/**
+		 * @brief Draws every circle queued since the last flush, and empties the queue.
+		 * @param renderer The renderer that handles the draw call
+		 * @return The number of SDL draw calls made (0 when there was nothing to draw or the call failed, 1 otherwise).
+		 */
+		int Flush( SDL_Renderer* renderer );
+
+		/**
+		 * @brief Returns the number of cached sprites.
+		 */
+		std::size_t GetSpriteCount() const { return mSprites.size(); }
+
+	private:
+		// A circle sprite's location in the atlas
+		struct Sprite
+		{
+			// Texture coordinates of the sprite's corners
+			float mU0, mV0, mU1, mV1;
+			// The sprite's width and height, in pixels
+			int mSize;
+		};
+
+		/**
+		 * @brief Returns a cached sprite, rasterizing it into the atlas if needed (null if it doesn't fit).
+		 */
+		const Sprite* GetSprite( int radius, const SDL_Color& color );
+
+	private:
+		// The atlas texture
+		std::unique_ptr<SDL_Texture, SDLTextureDeleter> mTexture;
+		// The atlas width and height
+		int mSize = 0;
+
+		// Cached sprites, keyed by radius (high bits) and RGBA color (low bits)
+		std::unordered_map<uint64_t, Sprite> mSprites;
+
+		// Shelf packing: the current shelf's top, its height, and the next free x on it
+		int mShelfY = 0;
+		int mShelfHeight = 0;
+		int mCursorX = 0;
+
+		// The queued circles quads
+		std::vector<SDL_Vertex> mVertices;
+		std::vector<int> mIndices;
+	};
+}
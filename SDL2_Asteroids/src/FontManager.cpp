@@ -0,0 +1,60 @@
+#include "FontManager.hpp"
+
+#include <cstdio>
+
+#include "AssetCache.hpp"
+
+namespace venture
+{
+	FontManager* FontManager::s_Instance = nullptr;
+
+	std::string FontManager::GetDefaultFontPath()
+	{
+		return std::string( SOLUTION_DIR ) + "Assets/fonts/pixeldue.ttf";
+	}
+
+	std::shared_ptr<TTF_Font> FontManager::GetFont( const std::string& path, int size )
+	{
+		FontEntry& entry = mFonts[ { path, size } ];
+		if ( entry.mFont == nullptr )
+		{
+			entry.mFont = AssetCache::get()->LoadFont( path, size );
+		}
+		return entry.mFont;
+	}
+
+	std::shared_ptr<GlyphAtlas> FontManager::GetGlyphAtlas( SDL_Renderer* renderer, const std::string& path, int size )
+	{
+		std::shared_ptr<TTF_Font> font = GetFont( path, size );
+		if ( font == nullptr )
+		{
+			return nullptr;
+		}
+
+		FontEntry& entry = mFonts[ { path, size } ];
+		if ( entry.mGlyphAtlas == nullptr )
+		{
+			auto atlas = std::make_shared<GlyphAtlas>();
+			if ( !atlas->Create( renderer, font.get() ) )
+			{
+				printf( "Failed to create the glyph atlas of %s (%d)!\n", path.c_str(), size );
+				return nullptr;
+			}
+			entry.mGlyphAtlas = std::move( atlas );
+		}
+		return entry.mGlyphAtlas;
+	}
+
+	void FontManager::Preload( SDL_Renderer* renderer, const std::string& path, std::initializer_list<int> sizes )
+	{
+		for ( int size : sizes )
+		{
+			GetGlyphAtlas( renderer, path, size );
+		}
+	}
+
+	void FontManager::Clean()
+	{
+		mFonts.clear();
+	}
+}
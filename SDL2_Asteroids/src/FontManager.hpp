@@ -0,0 +1,107 @@
+/**
+ * @class FontManager
+ * @brief Singleton cache of the opened fonts and their glyph atlases.
+ *
+ * Every (font file, point size) pair is opened once through the AssetCache, and every
+ * TextRenderer using that pair shares the same TTF_Font and GlyphAtlas. The atlases
+ * can be pre-warmed at startup, so creating a TextRenderer later (e.g. on a restart)
+ * doesn't touch the disk or rasterize anything.
+ *
+ * Example usage:
+ * @code
+ * auto fonts = venture::FontManager::get();
+ * fonts->Preload( renderer, venture::FontManager::GetDefaultFontPath(), { 20, 26, 30 } );
+ * std::shared_ptr<TTF_Font> font = fonts->GetFont( venture::FontManager::GetDefaultFontPath(), 20 );
+ * @endcode
+ *
+ * @note Call Clean() before TTF_Quit() and before the renderer is destroyed.
+ */
+
+#pragma once
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "GlyphAtlas.hpp"
+
+namespace venture
+{
+	class FontManager
+	{
+	public:
+		/**
+		 * @brief Retrieves the static instance of the class, creating one if it doesn't exist.
+		 */
+		static FontManager* get()
+		{
+			if ( s_Instance == nullptr )
+			{
+				s_Instance = new FontManager();
+			}
+			return s_Instance;
+		}
+
+		/**
+		 * @brief Returns the path of the game's default font.
+		 */
+		static std::string GetDefaultFontPath();
+
+		/// Fonts
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the font for a (file, size) pair, opening it on the first request.
+		 * @param path The font file.
+		 * @param size The font point size.
+		 * @return The shared font, null if it couldn't be opened.
+		 */
+		std::shared_ptr<TTF_Font> GetFont( const std::string& path, int size );
+
+		/**
+		 * @brief Returns the glyph atlas of a (file, size) pair, rasterizing it on the first request.
+		 * @param renderer The renderer that owns the atlas texture.
+		 * @param path The font file.
+		 * @param size The font point size.
+		 * @return The shared atlas, null if the font couldn't be opened or rasterized.
+		 */
+		std::shared_ptr<GlyphAtlas> GetGlyphAtlas( SDL_Renderer* renderer, const std::string& path, int size );
+
+		/**
+		 * @brief Opens the font at every size and rasterizes their glyph atlases ahead of time.
+		 */
+		void Preload( SDL_Renderer* renderer, const std::string& path, std::initializer_list<int> sizes );
+
+		/**
+		 * @brief Releases the manager's references to every font and atlas.
+		 */
+		void Clean();
+
+	private:
+		// A cached font and its (lazily created) glyph atlas
+		struct FontEntry
+		{
+			std::shared_ptr<TTF_Font> mFont;
+			std::shared_ptr<GlyphAtlas> mGlyphAtlas;
+		};
+
+		// Private constructor to follow the singleton design pattern.
+		FontManager() = default;
+
+		// The static instance of the class (to follow the singleton design pattern)
+		static FontManager* s_Instance;
+
+		// The cached fonts, keyed by (file, size)
+		std::map<std::pair<std::string, int>, FontEntry> mFonts;
+
+		// Deleted constructors and assignment operators for Singleton enforcement.
+		FontManager( FontManager&& ) = delete;
+		FontManager( const FontManager& ) = delete;
+		FontManager& operator=( FontManager&& ) = delete;
+		FontManager& operator=( const FontManager& ) = delete;
+	};
+}
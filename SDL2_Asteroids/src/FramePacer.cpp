@@ -0,0 +1,236 @@
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace venture
+{
+	const double FramePacer::SLEEP_ESTIMATE_WEIGHT = 0.05;
+
+	namespace
+	{
+		// The limiter's rate when the display doesn't report one
+		const float DEFAULT_REFRESH_RATE = 60.f;
+
+		double CounterToMs( Uint64 ticks )
+		{
+			return static_cast< double >( ticks ) * 1000.0 / SDL_GetPerformanceFrequency();
+		}
+
+		// Nearest rank percentile of sorted values
+		double Percentile( const std::vector<double>& sorted, double percentile )
+		{
+			if ( sorted.empty() )
+			{
+				return 0.0;
+			}
+			std::size_t rank = static_cast< std::size_t >( percentile / 100.0 * sorted.size() + 0.5 );
+			return sorted[ std::min( sorted.size() - 1, rank > 0 ? rank - 1 : 0 ) ];
+		}
+	}
+
+	void FramePacer::SetMode( PresentMode mode, float targetFps )
+	{
+		mMode = mode;
+		mTargetFps = targetFps > 0.f ? targetFps : DEFAULT_REFRESH_RATE;
+		Apply();
+	}
+
+	void FramePacer::Attach( SDL_Renderer* renderer, SDL_Window* window )
+	{
+		mRenderer = renderer;
+		mWindow = window;
+		Apply();
+	}
+
+	void FramePacer::Apply()
+	{
+		mEffectiveMode = mMode;
+		mLimiterFps = mTargetFps;
+		mNextFrameStart = 0;
+		ResetStats();
+
+		if ( mRenderer == nullptr )
+		{
+			return;
+		}
+
+		bool vsync = ( mMode == PresentMode::VSYNC );
+		SDL_RendererInfo info;
+		if ( SDL_RenderSetVSync( mRenderer, vsync ? 1 : 0 ) == 0 && SDL_GetRendererInfo( mRenderer, &info ) == 0 &&
+			 ( ( info.flags & SDL_RENDERER_PRESENTVSYNC ) != 0 ) == vsync )
+		{
+			return;
+		}
+		if ( !vsync )
+		{
+			printf( "(FramePacer): Failed to turn vsync off: %s\n", SDL_GetError() );
+			return;
+		}
+
+		// No vsync: limit to the display's rate instead of running frames back to back
+		SDL_DisplayMode displayMode;
+		int display = mWindow != nullptr ? SDL_GetWindowDisplayIndex( mWindow ) : 0;
+		mLimiterFps = ( SDL_GetCurrentDisplayMode( std::max( display, 0 ), &displayMode ) == 0 && displayMode.refresh_rate > 0 )
+			? static_cast< float >( displayMode.refresh_rate ) : DEFAULT_REFRESH_RATE;
+		mEffectiveMode = PresentMode::LIMITED;
+		printf( "(FramePacer): The renderer has no vsync, limiting to %.0f fps\n", mLimiterFps );
+	}
+
+	void FramePacer::WaitForFrameStart()
+	{
+		if ( mEffectiveMode == PresentMode::LIMITED )
+		{
+			const Uint64 period = static_cast< Uint64 >( SDL_GetPerformanceFrequency() / mLimiterFps );
+			Uint64 now = SDL_GetPerformanceCounter();
+
+			// The first frame, or more than a frame late (a hitch): start over from now instead of catching up
+			if ( mNextFrameStart == 0 || now > mNextFrameStart + period )
+			{
+				mNextFrameStart = now;
+			}
+			WaitUntil( mNextFrameStart );
+			mNextFrameStart += period;
+		}
+
+		Uint64 frameStart = SDL_GetPerformanceCounter();
+		if ( mLastFrameStart != 0 )
+		{
+			mIntervals[ mHistoryHead ] = static_cast< float >( CounterToMs( frameStart - mLastFrameStart ) );
+			mHistoryHead = ( mHistoryHead + 1 ) % HISTORY_SIZE;
+			mHistoryCount = std::min( mHistoryCount + 1, static_cast< int >( HISTORY_SIZE ) );
+		}
+		mLastFrameStart = frameStart;
+	}
+
+	void FramePacer::WaitUntil( Uint64 deadline )
+	{
+		// Nap while a nap can't overshoot the deadline, measuring every nap
+		Uint64 now = SDL_GetPerformanceCounter();
+		while ( now < deadline && CounterToMs( deadline - now ) > GetSleepEstimateMs() )
+		{
+			SDL_Delay( 1 );
+			Uint64 woken = SDL_GetPerformanceCounter();
+
+			double napMs = CounterToMs( woken - now );
+			double delta = napMs - mSleepMeanMs;
+			mSleepMeanMs += SLEEP_ESTIMATE_WEIGHT * delta;
+			mSleepVariance = ( 1.0 - SLEEP_ESTIMATE_WEIGHT ) * ( mSleepVariance + SLEEP_ESTIMATE_WEIGHT * delta * delta );
+			now = woken;
+		}
+
+		// Then spin the rest, letting the other threads (the job workers) run meanwhile
+		while ( SDL_GetPerformanceCounter() < deadline )
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	void FramePacer::ResetStats()
+	{
+		mLastFrameStart = 0;
+		mHistoryHead = 0;
+		mHistoryCount = 0;
+	}
+
+	bool FramePacer::ParseMode( const char* spec, PresentMode& mode, float& targetFps )
+	{
+		if ( std::strcmp( spec, "vsync" ) == 0 )
+		{
+			mode = PresentMode::VSYNC;
+			return true;
+		}
+		if ( std::strcmp( spec, "uncapped" ) == 0 )
+		{
+			mode = PresentMode::UNCAPPED;
+			return true;
+		}
+		if ( std::strncmp( spec, "limited", 7 ) == 0 && ( spec[ 7 ] == '\0' || spec[ 7 ] == ':' ) )
+		{
+			float fps = ( spec[ 7 ] == ':' ) ? static_cast< float >( std::atof( spec + 8 ) ) : DEFAULT_REFRESH_RATE;
+			if ( fps <= 0.f )
+			{
+				return false;
+			}
+			mode = PresentMode::LIMITED;
+			targetFps = fps;
+			return true;
+		}
+		return false;
+	}
+
+	const char* FramePacer::GetModeName( PresentMode mode )
+	{
+		switch ( mode )
+		{
+		case PresentMode::UNCAPPED:
+			return "uncapped";
+		case PresentMode::LIMITED:
+			return "limited";
+		default:
+			return "vsync";
+		}
+	}
+
+	std::string FramePacer::GetName() const
+	{
+		if ( mEffectiveMode == PresentMode::LIMITED )
+		{
+			return "limited:" + std::to_string( static_cast< int >( mLimiterFps + 0.5f ) );
+		}
+		return GetModeName( mEffectiveMode );
+	}
+
+	double FramePacer::GetJitterMs() const
+	{
+		if ( mHistoryCount < 2 )
+		{
+			return 0.0;
+		}
+
+		double sum = 0.0;
+		double sumSquares = 0.0;
+		for ( int i = 0; i < mHistoryCount; ++i )
+		{
+			sum += mIntervals[ i ];
+			sumSquares += static_cast< double >( mIntervals[ i ] ) * mIntervals[ i ];
+		}
+		double mean = sum / mHistoryCount;
+		return std::sqrt( std::max( 0.0, sumSquares / mHistoryCount - mean * mean ) );
+	}
+
+	PacingStats FramePacer::GetStats() const
+	{
+		PacingStats stats;
+		stats.mFrames = static_cast< std::size_t >( mHistoryCount );
+		if ( mHistoryCount == 0 )
+		{
+			return stats;
+		}
+
+		double sum = 0.0;
+		for ( int i = 0; i < mHistoryCount; ++i )
+		{
+			sum += mIntervals[ i ];
+		}
+		stats.mMeanMs = sum / mHistoryCount;
+		stats.mJitterMs = GetJitterMs();
+		stats.mTargetMs = ( mEffectiveMode == PresentMode::LIMITED ) ? 1000.0 / mLimiterFps : stats.mMeanMs;
+
+		std::vector<double> deviations;
+		deviations.reserve( mHistoryCount );
+		for ( int i = 0; i < mHistoryCount; ++i )
+		{
+			deviations.push_back( std::abs( mIntervals[ i ] - stats.mTargetMs ) );
+		}
+		std::sort( deviations.begin(), deviations.end() );
+		stats.mP50DeviationMs = Percentile( deviations, 50.0 );
+		stats.mP99DeviationMs = Percentile( deviations, 99.0 );
+		stats.mMaxDeviationMs = deviations.back();
+		return stats;
+	}
+}
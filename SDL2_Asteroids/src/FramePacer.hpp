@@ -0,0 +1,194 @@
+/**
+ * @class FramePacer
+ * @brief Paces the game loop: frames synced to the display (vsync), run back to back (uncapped), or started at a
+ * target rate by a limiter that sleeps most of the wait and spins the rest, for sub-millisecond accuracy.
+ *
+ * The limiter waits at the start of the frame, before the input is polled (late latching), so the input a frame
+ * consumes is as fresh as the frame rate allows. Sleeping overshoots by up to the OS timer's slice, so it naps
+ * 1 ms at a time while the time left is above what a nap has been measured to take (mean plus two standard
+ * deviations, kept up to date), then spins on the performance counter, yielding the core, until the deadline.
+ *
+ * Vsync is requested from the renderer, and can be switched at runtime. When the driver refuses it, the pacer falls
+ * back to the limiter at the display's refresh rate instead of running frames as fast as the cpu goes.
+ *
+ * It also records the intervals between the last frame starts, for the pacing jitter statistics.
+ *
+ * Example usage:
+ * @code
+ * venture::FramePacer pacer;
+ * pacer.SetMode( venture::PresentMode::LIMITED, 144.f );
+ * pacer.Attach( renderer, window );
+ * while ( running )
+ * {
+ *     pacer.WaitForFrameStart();
+ *     PollInput(); Update(); Render();
+ * }
+ * venture::PacingStats stats = pacer.GetStats();
+ * @endcode
+ *
+ * @note Not thread safe, the pacer must only be used from the game loop's thread.
+ */
+
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include <SDL2/SDL.h>
+
+namespace venture
+{
+	// How the frames are paced
+	enum class PresentMode
+	{
+		// SDL_RenderPresent waits for the display's vertical blank
+		VSYNC,
+		// The frames run back to back
+		UNCAPPED,
+		// The frames start at a target rate, waiting before the input is polled (late latching)
+		LIMITED
+	};
+
+	/**
+	 * @brief The pacing of the last frames, in milliseconds
+	 */
+	struct PacingStats
+	{
+		// Intervals between frame starts measured
+		std::size_t mFrames = 0;
+		// The interval the frames aim for: the limiter's period, the mean interval otherwise
+		double mTargetMs = 0.0;
+		// The mean interval
+		double mMeanMs = 0.0;
+		// Standard deviation of the intervals
+		double mJitterMs = 0.0;
+		// Deviations of the intervals from the target
+		double mP50DeviationMs = 0.0;
+		double mP99DeviationMs = 0.0;
+		double mMaxDeviationMs = 0.0;
+	};
+
+	class FramePacer
+	{
+	public:
+		// Frame intervals kept for the statistics
+		static const int HISTORY_SIZE = 600;
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Sets how the frames are paced, takes effect right away once attached.
+		 * @param targetFps The frame rate of PresentMode::LIMITED
+		 */
+		void SetMode( PresentMode mode, float targetFps = 60.f );
+
+		/**
+		 * @brief Attaches the renderer vsync is switched on and the window whose display rate the fallback uses.
+		 */
+		void Attach( SDL_Renderer* renderer, SDL_Window* window );
+
+		/**
+		 * @brief Waits until the next frame should start (only the limiter waits) and records the interval.
+		 */
+		void WaitForFrameStart();
+
+		/**
+		 * @brief Forgets the recorded intervals.
+		 */
+		void ResetStats();
+
+		/**
+		 * @brief Reads a present mode: vsync, uncapped, limited or limited:<fps>.
+		 * @return false if the spec isn't a present mode (the outputs are left untouched).
+		 */
+		static bool ParseMode( const char* spec, PresentMode& mode, float& targetFps );
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the mode asked for with SetMode.
+		 */
+		PresentMode GetMode() const { return mMode; }
+
+		/**
+		 * @brief Returns the mode the frames are actually paced with (the limiter when vsync was refused).
+		 */
+		PresentMode GetEffectiveMode() const { return mEffectiveMode; }
+
+		/**
+		 * @brief Returns the frame rate asked for PresentMode::LIMITED.
+		 */
+		float GetTargetFps() const { return mTargetFps; }
+
+		/**
+		 * @brief Returns the frame rate the limiter aims for (the display's rate when vsync was refused).
+		 */
+		float GetLimiterFps() const { return mLimiterFps; }
+
+		/**
+		 * @brief Returns the effective mode as ParseMode reads it (e.g. vsync, limited:60).
+		 */
+		std::string GetName() const;
+
+		/**
+		 * @brief Returns a mode's name, without the frame rate.
+		 */
+		static const char* GetModeName( PresentMode mode );
+
+		/**
+		 * @brief Returns the standard deviation of the recorded intervals, in milliseconds (cheap, no sorting).
+		 */
+		double GetJitterMs() const;
+
+		/**
+		 * @brief Returns the pacing statistics over the recorded intervals.
+		 */
+		PacingStats GetStats() const;
+
+		/**
+		 * @brief Returns how long a 1 ms nap is expected to take at most, in milliseconds.
+		 */
+		double GetSleepEstimateMs() const { return mSleepMeanMs + 2.0 * std::sqrt( mSleepVariance ); }
+
+	private:
+		/**
+		 * @brief Switches vsync on the renderer and picks the effective mode.
+		 */
+		void Apply();
+
+		/**
+		 * @brief Sleeps then spins until a performance counter value.
+		 */
+		void WaitUntil( Uint64 deadline );
+
+		// Weight of the latest nap in the sleep estimate
+		static const double SLEEP_ESTIMATE_WEIGHT;
+
+		// The mode asked for, and the one used
+		PresentMode mMode = PresentMode::VSYNC;
+		PresentMode mEffectiveMode = PresentMode::VSYNC;
+		// The frame rate asked for, and the one the limiter uses (the display's rate when vsync was refused)
+		float mTargetFps = 60.f;
+		float mLimiterFps = 60.f;
+
+		SDL_Renderer* mRenderer = nullptr;
+		SDL_Window* mWindow = nullptr;
+
+		// Performance counter value the next limited frame starts at, 0 to start over
+		Uint64 mNextFrameStart = 0;
+		// Performance counter value the last frame started at, 0 before the first one
+		Uint64 mLastFrameStart = 0;
+
+		// How long a 1 ms nap takes: its moving mean and variance, in milliseconds (starts pessimistic)
+		double mSleepMeanMs = 2.0;
+		double mSleepVariance = 0.0;
+
+		// The last intervals between frame starts (a ring, mHistoryHead is the next one written)
+		std::array<float, HISTORY_SIZE> mIntervals = {};
+		int mHistoryHead = 0;
+		int mHistoryCount = 0;
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// How long each phase of a frame took, in milliseconds.
+// Game::RunFrame fills one every frame (see Game::GetFrameTimings). The update runs on a job
+// while the main thread renders, so the phases overlap and don't add up to the frame time.
+
+struct FrameTimings
+{
+	// Polling the events and the ship's input
+	double mInput = 0.0;
+	// The simulation tick, without the collision phase
+	double mUpdate = 0.0;
+	// Building the broadphase, checking the ship and the bullets against it, applying the hits
+	double mCollision = 0.0;
+	// Filling the line batch and the sprite batches, and submitting them
+	double mRenderPrep = 0.0;
+	// SDL_RenderPresent
+	double mPresent = 0.0;
+	// The whole frame
+	double mFrame = 0.0;
+
+	/**
+	 * @brief Returns the milliseconds elapsed since a SDL_GetPerformanceCounter() value.
+	 */
+	static double ElapsedMs( Uint64 start )
+	{
+		return static_cast< double >( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency();
+	}
+};
@@ -1,5 +1,8 @@
 #include "Game.h"
 #include "InputManager.hpp"
+#include "Kinematics.h"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
 #include <iostream>
 #include <random>
 
@@ -10,9 +13,29 @@ const float Game::MIN_Y_VELOCITY = -30.0f;
 const float Game::MAX_Y_VELOCITY =  30.0f;
 const float Game::MIN_ROT = -1.0f;
 const float Game::MAX_ROT =  1.0f;
+const glm::vec2 Game::SHIP_START_POSITION = { 400.f, 500.f };
 
-bool Game::Init( const char* title, bool fullscreen )
+namespace
 {
+	// The sound played when a game starts
+	std::string GetStartGameSoundPath()
+	{
+		return std::string( SOLUTION_DIR ) + "Assets/RestartGame.wav";
+	}
+}
+
+bool Game::Init( const char* title, bool fullscreen, bool headless )
+{
+	// SDL's own allocations (chunks, surfaces, pixels) are counted too, hooked before SDL allocates anything
+	AllocationTracker::HookSdlAllocations();
+
+	// Headless runs draw with the software renderer into the dummy video driver's offscreen window
+	if ( headless )
+	{
+		SDL_SetHint( SDL_HINT_VIDEODRIVER, "dummy" );
+		SDL_SetHint( SDL_HINT_RENDER_DRIVER, "software" );
+	}
+
 	if ( SDL_Init( SDL_INIT_EVERYTHING ) < 0 )
 	{
 		std::cout << "Failed to initialize SDL! SDL_Error: " << SDL_GetError() << '\n';
@@ -34,12 +57,56 @@ bool Game::Init( const char* title, bool fullscreen )
 		return false;
 	}
 
-	mRenderer = SDL_CreateRenderer( mWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC );
+	// ASTEROIDS_PRESENT overrides the present mode (vsync, uncapped, limited or limited:<fps>)
+	if ( const char* presentSpec = SDL_getenv( "ASTEROIDS_PRESENT" ) )
+	{
+		PresentMode mode = mFramePacer.GetMode();
+		float targetFps = mFramePacer.GetTargetFps();
+		if ( FramePacer::ParseMode( presentSpec, mode, targetFps ) )
+		{
+			mFramePacer.SetMode( mode, targetFps );
+		}
+		else
+		{
+			printf( "Unknown present mode %s, using %s\n", presentSpec, mFramePacer.GetName().c_str() );
+		}
+	}
+	// Without a display there is nothing to sync to, headless runs go as fast as they can unless limited
+	if ( headless && mFramePacer.GetMode() == PresentMode::VSYNC )
+	{
+		mFramePacer.SetMode( PresentMode::UNCAPPED );
+	}
+
+	// ASTEROIDS_LOG_RESTARTS prints how long every restart takes
+	if ( SDL_getenv( "ASTEROIDS_LOG_RESTARTS" ) != nullptr )
+	{
+		mLogRestarts = true;
+	}
+
+	// ASTEROIDS_LATENCY records the input to photon latency, written there on exit
+	if ( SDL_getenv( "ASTEROIDS_LATENCY" ) != nullptr )
+	{
+		mInputLatency.SetEnabled( true );
+	}
+
+	Uint32 renderer_flags = headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+	if ( mFramePacer.GetMode() == PresentMode::VSYNC )
+	{
+		renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+	}
+	mRenderer = SDL_CreateRenderer( mWindow, -1, renderer_flags );
 	if ( mRenderer == nullptr )
 	{
 		std::cout << "Failed to Create Renderer! SDL_Error: " << SDL_GetError() << '\n';
 		return false;
 	}
+	// Falls back to the limiter when the renderer has no vsync
+	mFramePacer.Attach( mRenderer, mWindow );
+
+	if ( !mCircleAtlas.Create( mRenderer ) )
+	{
+		return false;
+	}
 
 	int image_flags = IMG_INIT_PNG | IMG_INIT_JPG;
 	if ( !( IMG_Init( image_flags ) & image_flags ) )
@@ -54,13 +121,43 @@ bool Game::Init( const char* title, bool fullscreen )
 		return false;
 	}
 
-	if ( Mix_OpenAudio( 44100, MIX_DEFAULT_FORMAT, 2, 2048 ) < 0 )
+	// One mapping for every asset when the packed archive was built, the loose files otherwise
+	AssetCache::get()->MountArchive( std::string( SOLUTION_DIR ) + "Assets.pak", std::string( SOLUTION_DIR ) + "Assets/" );
+
+
+	// Without an audio device (or with ASTEROIDS_NULL_AUDIO set) the game runs silently on the null backend
+	if ( headless || SDL_getenv( "ASTEROIDS_NULL_AUDIO" ) != nullptr )
 	{
-		std::cout << "SDL_Mixer could not initialize! Mix_Error : " << Mix_GetError() << std::endl;
-		return false;
+		SetAudioBackend( std::make_unique<NullAudioBackend>() );
+	}
+	else if ( Mix_OpenAudio( 44100, MIX_DEFAULT_FORMAT, 2, 2048 ) < 0 )
+	{
+		std::cout << "SDL_Mixer could not initialize! Mix_Error : " << Mix_GetError() << ", running without sound" << std::endl;
+		SetAudioBackend( std::make_unique<NullAudioBackend>() );
 	}
+	else
+	{
+		SetAudioBackend( std::make_unique<SdlMixerAudioBackend>() );
+	}
+
+	mJobSystem = std::make_unique<JobSystem>();
 
-	RestartGame();
+	// The assets load on the workers while the window shows a loading screen,
+	// the game starts once they are all in the cache (see UpdateLoading)
+	mLoader = std::make_unique<AsyncLoader>( *mJobSystem );
+	for ( int fontSize : { PerfHud::FONT_SIZE, 20, 26, 30 } )
+	{
+		mLoader->QueueFont( FontManager::GetDefaultFontPath(), fontSize );
+	}
+	if ( mAudio->DecodesSounds() )
+	{
+		for ( const std::string& soundPath : Ship::GetSoundPaths() )
+		{
+			mLoader->QueueSound( soundPath );
+		}
+		mLoader->QueueSound( GetStartGameSoundPath() );
+	}
+	mLoader->Start();
 
 	mIsRunning = true;
 	return true;
@@ -68,13 +165,23 @@ bool Game::Init( const char* title, bool fullscreen )
 
 void Game::Update()
 {
+	PROFILE_ZONE( "Update" );
+	ALLOCATION_TAG( "Update" );
+	Uint64 updateStart = SDL_GetPerformanceCounter();
+	mFrameTimings.mCollision = 0.0;
+	mCollisionPairs.store( 0, std::memory_order_relaxed );
+
 	mDeltaTime = ( mTimer->PeekMilliseconds() - mTicksCount ) / 1000.0f;
 	if ( mDeltaTime > 0.05f )
 		mDeltaTime = 0.05f;
 
 	mTicksCount = mTimer->PeekMilliseconds();
 
-	mFPS = 1.0 / mDeltaTime;
+	if ( mFixedTimeStep > 0.f )
+	{
+		mDeltaTime = mFixedTimeStep;
+	}
+	mSimTime += mDeltaTime;
 
 	mPlayerWon = mAsteroidsMap.empty();
 
@@ -82,54 +189,181 @@ void Game::Update()
 	{
 		if ( !mShip->GetIsDead())
 		{
+			// Ship and bullets movement
 			mShip->Update( mDeltaTime );
 
-			mScoreStr = "Score: " + std::to_string( mScoreCount );
-			mScoreText->UpdateText( mScoreStr );
+			// Pack the asteroids for the jobs below
+			PackAsteroids();
 
-			WrapCoordinates( mShip->GetSpaceObject() );
+			ALLOCATION_TAG( "Collision" );
+			Uint64 collisionStart = SDL_GetPerformanceCounter();
+
+			// The broadphase is built across the cores, and keeps a snapshot of the asteroids before they move,
+			// so moving the asteroids and checking the bullets against them can overlap.
+			mAsteroidBroadphase.Build( mAsteroidKinematics, *mJobSystem, BROADPHASE_GRAIN_SIZE );
+
+			float deltaTime = mDeltaTime;
+			JobHandle asteroidsMoved = mJobSystem->ScheduleParallelFor( mAsteroidKinematics.Size(), KINEMATICS_GRAIN_SIZE,
+				[ this, deltaTime ]( std::size_t begin, std::size_t end )
+				{
+					ALLOCATION_TAG( "Update" );
+					Kinematics::IntegrateRange( mAsteroidKinematics, begin, end, deltaTime, true );
+				} );
+
+			JobHandle bulletHits = mJobSystem->ScheduleParallelFor( mShip->GetBulletCount(), COLLISION_GRAIN_SIZE,
+				[ this ]( std::size_t begin, std::size_t end )
+				{
+					ALLOCATION_TAG( "Collision" );
+					int pairs = mShip->FindBulletHits( mAsteroidBroadphase, begin, end );
+					mCollisionPairs.fetch_add( pairs, std::memory_order_relaxed );
+				} );
+
+			mShip->CheckAsteroidsCollision( mAsteroidBroadphase );
+
+			mJobSystem->Wait( asteroidsMoved );
+			mJobSystem->Wait( bulletHits );
 
+			// Copy the moved asteroids back (before any asteroid gets added or removed)
+			std::size_t i = 0;
 			for ( auto& a : mAsteroidsMap )
 			{
+				SpaceObject& obj = a.second.GetSpaceObject();
+				obj.mPosition.x = mAsteroidKinematics.mPositionsX[ i ];
+				obj.mPosition.y = mAsteroidKinematics.mPositionsY[ i ];
 				a.second.Update( mDeltaTime );
+				++i;
 			}
+
+			mShip->UpdateBullets();
+			mFrameTimings.mCollision = FrameTimings::ElapsedMs( collisionStart );
+
+			WrapCoordinates( mShip->GetSpaceObject() );
 		}
 	}
+
+	// The frame's sound requests reach the mixer in one go, positioned around the ship
+	if ( mShip )
+	{
+		const glm::vec2& listener = mShip->GetSpaceObject().mPosition;
+		mVoices.SetListener( listener.x, listener.y );
+	}
+	{
+		ALLOCATION_TAG( "Audio" );
+		mVoices.Flush();
+	}
+
+	WriteRenderSnapshot();
+
+	mFrameTimings.mUpdate = FrameTimings::ElapsedMs( updateStart ) - mFrameTimings.mCollision;
+}
+
+void Game::WriteRenderSnapshot()
+{
+	RenderSnapshot& snapshot = mRenderSnapshots.GetWriteBuffer();
+
+	snapshot.mTick = mTickIndex;
+	snapshot.mAsteroids.clear();
+	for ( auto& a : mAsteroidsMap )
+	{
+		const SpaceObject& obj = a.second.GetSpaceObject();
+		snapshot.mAsteroids.push_back( { obj.mPosition.x, obj.mPosition.y, obj.mRotation, static_cast< float >( obj.mSize ),
+										 a.second.GetShapeId(), a.second.GetColor() } );
+	}
+
+	snapshot.mHasShip = mShip != nullptr;
+	if ( mShip )
+	{
+		mShip->WriteRenderSnapshot( snapshot );
+	}
+
+	snapshot.mPlayerWon = mPlayerWon;
+	snapshot.mScore = mScoreCount;
+
+	mRenderSnapshots.Publish();
 }
 
 void Game::Render()
 {
+	PROFILE_ZONE( "Render" );
+	ALLOCATION_TAG( "Render" );
+	Uint64 renderStart = SDL_GetPerformanceCounter();
+	// Only the snapshot is read here, the simulation may be running the next tick meanwhile
+	const RenderSnapshot& snapshot = mRenderSnapshots.GetReadBuffer();
+
+	mDrawCallCount = 0;
+
 	// Prepare scene
 	SDL_SetRenderDrawColor( mRenderer, 0, 0, 0, 255 );
 	SDL_RenderClear( mRenderer );
-	if ( mShip )
+	if ( snapshot.mHasShip )
 	{
-		if ( !mShip->GetIsDead() )
+		if ( !snapshot.mShipDead )
 		{
-			mShip->Render( mRenderer );
+			Ship::Render( snapshot );
 
-			for ( auto& a : mAsteroidsMap )
+			// Allocate the asteroids wire frames in the line batch, then transform them straight into it in parallel
+			const auto& asteroids = snapshot.mAsteroids;
+			mAsteroidSlots.clear();
+			for ( const auto& asteroid : asteroids )
 			{
-				a.second.Render( mRenderer );
+				mAsteroidSlots.push_back( mLineBatcher.AllocatePolygon( Asteroid::GetShape( asteroid.mShapeId ).size(), asteroid.mColor ) );
 			}
 
+			mJobSystem->ParallelFor( asteroids.size(), RENDER_GRAIN_SIZE, [ this, &asteroids ]( std::size_t begin, std::size_t end )
+				{
+					ALLOCATION_TAG( "Render" );
+					for ( std::size_t i = begin; i < end; ++i )
+					{
+						const AsteroidRenderData& asteroid = asteroids[ i ];
+						TransformWireFrameModel( Asteroid::GetShape( asteroid.mShapeId ), asteroid.mX, asteroid.mY,
+												 asteroid.mRotation, asteroid.mSize, mLineBatcher.GetPolygonPoints( mAsteroidSlots[ i ] ) );
+					}
+				} );
+
+			// Every wire frame (ship and asteroids) in one go, then every bullet
+			mDrawCallCount += mLineBatcher.Flush( mRenderer );
+			mDrawCallCount += mCircleAtlas.Flush( mRenderer );
+
+			// The score texture is only recreated when the score changes
+			if ( snapshot.mScore != mRenderedScore )
+			{
+				ALLOCATION_TAG( "Text" );
+				mRenderedScore = snapshot.mScore;
+				mScoreStr = "Score: " + std::to_string( mRenderedScore );
+				mScoreText->UpdateText( mScoreStr );
+			}
 			mScoreText->RenderText( mRenderer, { 10.f, mScoreText->GetTextSize().y } );
+			++mDrawCallCount;
 
-			if ( mPlayerWon )
+			if ( snapshot.mPlayerWon )
 			{
 				mWinText->RenderText( mRenderer, { 300.f, 250.f } );
 				mRestartText->RenderText( mRenderer, { 150.f, 300.f } );
+				mDrawCallCount += 2;
 			}
 		}
 		else
 		{
 			mDeadText->RenderText( mRenderer, { 300.f, 250.f } );
 			mRestartText->RenderText( mRenderer, { 150.f, 300.f } );
-
+			mDrawCallCount += 2;
 		}
 	}
+	mDrawCallCount += mPerfHud.Render( mRenderer );
+
+	mFrameTimings.mRenderPrep = FrameTimings::ElapsedMs( renderStart );
+
 	// Present scene
-	SDL_RenderPresent( mRenderer );
+	{
+		PROFILE_ZONE( "SDL_RenderPresent" );
+		Uint64 presentStart = SDL_GetPerformanceCounter();
+		SDL_RenderPresent( mRenderer );
+		mFrameTimings.mPresent = FrameTimings::ElapsedMs( presentStart );
+	}
+	if ( mInputLatency.IsEnabled() )
+	{
+		mInputLatency.AddPresent( snapshot.mTick, SDL_GetPerformanceCounter() );
+	}
 }
 
 
@@ -140,8 +374,28 @@ void Game::Clean()
 		a.second.Clean();
 	}
 
-	mShip->Clean();
+	// Quitting during the loading screen: let the decoding jobs finish first
+	mLoader.reset();
+
+	if ( mShip )
+	{
+		mShip->Clean();
+		delete mShip;
+		mShip = nullptr;
+	}
 
+	mCircleAtlas.Clean();
+
+	// The text renderers share the cached fonts, release them before closing the fonts
+	mWinText.reset();
+	mDeadText.reset();
+	mRestartText.reset();
+	mScoreText.reset();
+	FontManager::get()->Clean();
+	// The SDL_mixer backend holds its sounds until it's destroyed
+	mVoices.HaltAll();
+	mAudio.reset();
+	AssetCache::get()->Clean();
 
 	SDL_DestroyRenderer( mRenderer );
 	mRenderer = nullptr;
@@ -152,6 +406,23 @@ void Game::Clean()
 	delete mTimer;
 	mTimer = nullptr;
 
+	mJobSystem.reset();
+
+	// Every thread stopped recording, write the profiler's zones if a trace was asked for
+	if ( const char* tracePath = SDL_getenv( "ASTEROIDS_TRACE" ) )
+	{
+		PROFILE_WRITE_TRACE( tracePath );
+	}
+
+	// The input latency measured this run, if it was asked for (only once, Clean may run twice)
+	const char* latencyPath = SDL_getenv( "ASTEROIDS_LATENCY" );
+	if ( latencyPath != nullptr && mInputLatency.IsEnabled() )
+	{
+		mInputLatency.PrintSummary( mFramePacer.GetName().c_str() );
+		mInputLatency.WriteCsv( latencyPath, mFramePacer.GetName().c_str() );
+		mInputLatency.SetEnabled( false );
+	}
+
 	TTF_Quit();
 	IMG_Quit();
 
@@ -162,6 +433,8 @@ void Game::Clean()
 
 void Game::ProcessInput()
 {
+	PROFILE_ZONE( "ProcessInput" );
+	ALLOCATION_TAG( "Input" );
 	SDL_Event event;
 	auto input = InputManager::get();
 	input->ProcessInput( &event );
@@ -171,6 +444,19 @@ void Game::ProcessInput()
 		Quit();
 	}
 
+	if ( input->isKeyPressed( SDL_SCANCODE_F3 ) )
+	{
+		mPerfHud.Toggle();
+	}
+
+	// Cycles the frame pacing: vsync, uncapped, limited
+	if ( input->isKeyPressed( SDL_SCANCODE_F4 ) )
+	{
+		PresentMode next = ( mFramePacer.GetMode() == PresentMode::VSYNC ) ? PresentMode::UNCAPPED
+			: ( mFramePacer.GetMode() == PresentMode::UNCAPPED ) ? PresentMode::LIMITED : PresentMode::VSYNC;
+		mFramePacer.SetMode( next, mFramePacer.GetTargetFps() );
+	}
+
 	if ( mShip )
 	{
 		if ( mShip->GetIsDead() || mPlayerWon )
@@ -188,155 +474,205 @@ void Game::RunGame()
 {
 	while ( mIsRunning )
 	{
-		ProcessInput();
-		Update();
-		Render();
-
-		InputManager::get()->UpdatePrevInput();
-
+		RunFrame();
 	}
 	Clean();
 }
 
-
-void Game::DrawWireFrameModel( SDL_Renderer* renderer, const std::vector<std::pair<float, float>>& vecModelCoordinates, float x, float y, float r, float s )
+void Game::RunFrame()
 {
-	// Create translated model vector of coordinate pairs
-	std::vector<std::pair<float, float>> vecTransformedCoordinates;
-	auto verts = vecModelCoordinates.size();
-	vecTransformedCoordinates.resize( verts );
+	// The limiter waits here, before the input is polled (late latching)
+	mFramePacer.WaitForFrameStart();
 
-	// Rotate
-	for ( int i = 0; i < verts; i++ )
+	Uint64 frameStart = SDL_GetPerformanceCounter();
+	AllocationTracker::Snapshot frameAllocations = AllocationTracker::TakeSnapshot();
+
+	// Input (and restarts) are handled while the simulation is idle
+	ProcessInput();
+	mFrameTimings.mInput = FrameTimings::ElapsedMs( frameStart );
+
+	if ( mLoader && !UpdateLoading() )
 	{
-		vecTransformedCoordinates[ i ].first = vecModelCoordinates[ i ].first * cosf( r ) - vecModelCoordinates[ i ].second * sinf( r );
-		vecTransformedCoordinates[ i ].second = vecModelCoordinates[ i ].first * sinf( r ) + vecModelCoordinates[ i ].second * cosf( r );
+		InputManager::get()->UpdatePrevInput();
+		mFrameTimings.mFrame = FrameTimings::ElapsedMs( frameStart );
+		mFrameAllocations = AllocationTracker::TakeSnapshot().Since( frameAllocations );
+		return;
 	}
 
-	// Scale
-	for ( int i = 0; i < verts; i++ )
+	// The tick scheduled below consumes this frame's presses
+	++mTickIndex;
+	RecordInputLatency();
+
+	// Two stage pipeline: simulate the next tick while submitting the previous tick's snapshot
+	JobHandle simulation = mJobSystem->Schedule( [ this ]() { Update(); } );
+	Render();
+	mJobSystem->Wait( simulation );
+
+	// The timers fire between two ticks, while the simulation is idle
+	mTimerWheel.AdvanceTo( static_cast< uint64_t >( mSimTime * 1000.0 ) );
+
+	InputManager::get()->UpdatePrevInput();
+	mFrameTimings.mFrame = FrameTimings::ElapsedMs( frameStart );
+	mFrameAllocations = AllocationTracker::TakeSnapshot().Since( frameAllocations );
+
+	// Shown by the next frames (the overlay draws before this frame ends)
+	PerfHudFrame hudFrame;
+	hudFrame.mFrameMs = static_cast< float >( mFrameTimings.mFrame );
+	hudFrame.mAsteroids = static_cast< int >( mAsteroidsMap.size() );
+	hudFrame.mBullets = mShip ? static_cast< int >( mShip->GetBulletCount() ) : 0;
+	hudFrame.mDrawCalls = mDrawCallCount;
+	hudFrame.mCollisionPairs = mCollisionPairs.load( std::memory_order_relaxed );
+	hudFrame.mPacingMode = FramePacer::GetModeName( mFramePacer.GetEffectiveMode() );
+	hudFrame.mPacingFps = ( mFramePacer.GetEffectiveMode() == PresentMode::LIMITED ) ? mFramePacer.GetLimiterFps() : 0.f;
+	hudFrame.mPacingJitterMs = static_cast< float >( mFramePacer.GetJitterMs() );
+	if ( AllocationTracker::IsEnabled() )
 	{
-		vecTransformedCoordinates[ i ].first *= s;
-		vecTransformedCoordinates[ i ].second *= s;
+		hudFrame.mAllocations = static_cast< int64_t >( mFrameAllocations.mTotal.mAllocations );
 	}
+	mPerfHud.AddFrame( hudFrame );
+}
 
-	// Translate
-	for ( int i = 0; i < verts; i++ )
+void Game::RecordInputLatency()
+{
+	if ( !mInputLatency.IsEnabled() )
 	{
-		vecTransformedCoordinates[ i ].first += x;
-		vecTransformedCoordinates[ i ].second += y;
+		return;
 	}
 
-	// Draw Closed Polygon
-	for ( int i = 0; i < verts; i++ )
+	auto input = InputManager::get();
+	for ( std::size_t i = 0; i < input->GetFrameEventCount(); ++i )
 	{
-		int j = ( i + 1 ) % verts;
+		const InputEvent& event = input->GetFrameEvent( i );
+		if ( event.mType == InputEventType::KEY_DOWN || event.mType == InputEventType::MOUSE_BUTTON_DOWN )
+		{
+			mInputLatency.AddInput( mTickIndex, event.mPollCounter, input->GetEventAge( event ) );
+		}
+	}
+}
 
-		// Use double for intermediate calculations
-		auto ax = static_cast< double >( vecTransformedCoordinates[ i ].first );
-		auto ay = static_cast< double >( vecTransformedCoordinates[ i ].second );
-		auto bx = static_cast< double >( vecTransformedCoordinates[ j ].first );
-		auto by = static_cast< double >( vecTransformedCoordinates[ j ].second );
+bool Game::UpdateLoading()
+{
+	ALLOCATION_TAG( "Loading" );
+	mLoader->Update( mRenderer );
 
-		// Clamp values to the range of int
-		auto clampToIntRange = []( double value )
-			{
-				constexpr double Max = std::numeric_limits<float>::max();
-				constexpr double Min = std::numeric_limits<float>::min();
-				return static_cast< int >( std::max( Min, std::min( Max, value ) ) );
-			};
+	if ( mLoader->IsDone() )
+	{
+		mLoader.reset();
+		RestartGame();
+		return true;
+	}
 
-		glm::vec2 A( clampToIntRange( ax ), clampToIntRange( ay ) );
-		glm::vec2 B( clampToIntRange( bx ), clampToIntRange( by ) );
+	// Loading screen: a progress bar
+	const float progress = mLoader->GetProgress();
+	const SDL_FRect frame = { SCREEN_WIDTH * 0.25f, SCREEN_HEIGHT * 0.5f - 10.f, SCREEN_WIDTH * 0.5f, 20.f };
+	const SDL_FRect bar = { frame.x, frame.y, frame.w * progress, frame.h };
 
-		SDL_RenderDrawLineF( renderer, A.x, A.y, B.x, B.y );
-	}
+	SDL_SetRenderDrawColor( mRenderer, 0, 0, 0, 255 );
+	SDL_RenderClear( mRenderer );
+	SDL_SetRenderDrawColor( mRenderer, 0, 255, 0, 255 );
+	SDL_RenderFillRectF( mRenderer, &bar );
+	SDL_RenderDrawRectF( mRenderer, &frame );
+	SDL_RenderPresent( mRenderer );
+	return false;
+}
+
+void Game::DrawWireFrameModel( const std::vector<std::pair<float, float>>& vecModelCoordinates, float x, float y, float r, float s, const SDL_Color& color )
+{
+	PROFILE_ZONE( "DrawWireFrameModel" );
+	LinePolygonSlot slot = mLineBatcher.AllocatePolygon( vecModelCoordinates.size(), color );
+	TransformWireFrameModel( vecModelCoordinates, x, y, r, s, mLineBatcher.GetPolygonPoints( slot ) );
+}
 
+void Game::TransformWireFrameModel( const std::vector<std::pair<float, float>>& vecModelCoordinates, float x, float y, float r, float s, SDL_FPoint* outPoints )
+{
+	Transform2D::FromRotationScaleTranslation( x, y, r, s ).Apply( vecModelCoordinates.data(), vecModelCoordinates.size(), outPoints );
 }
 
 void Game::WrapCoordinates( SpaceObject& obj )
 {
-	auto fSize = static_cast< float >( obj.mSize );
+	Kinematics::Wrap( obj );
+}
 
-	if ( obj.mPosition.x > SCREEN_WIDTH + fSize )
-	{
-		obj.mPosition.x = -fSize;
-	}
-	else if ( obj.mPosition.x < -fSize )
-	{
-		obj.mPosition.x = SCREEN_WIDTH + fSize;
-	}
+void Game::DrawCircleFill( float centerX, float centerY, float mRadius, SDL_Color color )
+{
+	// The circle is rasterized once into the atlas, this only queues a textured quad
+	mCircleAtlas.AddCircle( centerX, centerY, mRadius, color );
+}
 
-	if ( obj.mPosition.y > SCREEN_HEIGHT + fSize )
-	{
-		obj.mPosition.y = -fSize;
-	}
-	else if ( obj.mPosition.y < -fSize )
-	{
-		obj.mPosition.y = SCREEN_HEIGHT + fSize;
-	}
+bool Game::IsPointInCircle( float cx, float cy, float mRadius, float x, float y )
+{
+	return sqrt( ( x - cx ) * ( x - cx ) + ( y - cy ) * ( y - cy ) ) < mRadius;
 }
 
-void Game::DrawCircleFill( SDL_Renderer* renderer, float centerX, float centerY, float mRadius, SDL_Color color )
+void Game::SetAudioBackend( std::unique_ptr<IAudioBackend> audio )
 {
-	// Set the draw color
-	SDL_SetRenderDrawColor( renderer, color.r, color.g, color.b, color.a );
+	mAudio = std::move( audio );
+	mVoices.Init( mAudio.get() );
+	mVoices.SetField( static_cast< float >( SCREEN_WIDTH ), static_cast< float >( SCREEN_HEIGHT ) );
+}
 
-	// Draw a filled circle
-	for ( float w = 0; w < mRadius * 2; w++ )
+void Game::PackAsteroids()
+{
+	mAsteroidKinematics.Clear();
+	mAsteroidIds.clear();
+	for ( auto& a : mAsteroidsMap )
 	{
-		for ( float h = 0; h < mRadius * 2; h++ )
-		{
-			float dx = mRadius - w; // horizontal offset
-			float dy = mRadius - h; // vertical offset
-			if ( ( dx * dx + dy * dy ) <= ( mRadius * mRadius ) )
-			{
-				SDL_RenderDrawPointF( renderer, centerX + dx, centerY + dy );
-			}
-		}
+		mAsteroidKinematics.Push( a.second.GetSpaceObject() );
+		mAsteroidIds.push_back( a.first );
 	}
 }
 
-bool Game::IsPointInCircle( float cx, float cy, float mRadius, float x, float y )
+void Game::AddAsteroid( const SpaceObject& obj )
 {
-	return sqrt( ( x - cx ) * ( x - cx ) + ( y - cy ) * ( y - cy ) ) < mRadius;
+	++mAsteroidsIndex;
+	Asteroid asteroid( obj, SDL_Color( 255, 255, 0, 255 ), mRng );
+	if ( mFreeAsteroidNodes.empty() )
+	{
+		mAsteroidsMap.insert( { mAsteroidsIndex, asteroid } );
+		return;
+	}
+
+	auto node = std::move( mFreeAsteroidNodes.back() );
+	mFreeAsteroidNodes.pop_back();
+	node.key() = mAsteroidsIndex;
+	node.mapped() = asteroid;
+	mAsteroidsMap.insert( std::move( node ) );
 }
 
-void Game::AddAsteroid( const SpaceObject& obj )
+void Game::RemoveAsteroid( std::unordered_map<int, Asteroid>::iterator asteroid )
 {
-	++mAsteroidsIndex;
-	mAsteroidsMap.insert( { mAsteroidsIndex, Asteroid( obj, SDL_Color( 255, 255, 0, 255 ) ) } );
+	mFreeAsteroidNodes.push_back( mAsteroidsMap.extract( asteroid ) );
 }
 
 void Game::AddRandomAsteroids()
 {
-	static std::mt19937 rng( std::random_device{}( ) );
 	// Random Asteroids Count
-	static std::uniform_int_distribution<int> asteroidsDist( MIN_ASTEROIDS_COUNT, MIN_ASTEROIDS_COUNT );
+	std::uniform_int_distribution<int> asteroidsDist( mScenario.mMinAsteroids, mScenario.mMaxAsteroids );
 	// Random Position On the Screen in Between (0,0)->(ScreenWidth,ScreenHeight)
-	static std::uniform_real_distribution<float> screenWidthDist( 0.f, static_cast<float>(SCREEN_WIDTH) );
-	static std::uniform_real_distribution<float> screenHeightDist( 0.f, static_cast< float >( SCREEN_HEIGHT - 200) );
+	std::uniform_real_distribution<float> screenWidthDist( 0.f, static_cast<float>(SCREEN_WIDTH) );
+	std::uniform_real_distribution<float> screenHeightDist( 0.f, static_cast< float >( SCREEN_HEIGHT - 200) );
 	// Random Velocity 
-	static std::uniform_real_distribution<float> xVelocityDist( MIN_X_VELOCITY, MAX_X_VELOCITY );
-	static std::uniform_real_distribution<float> yVelocityDist( MIN_Y_VELOCITY, MAX_Y_VELOCITY );
+	std::uniform_real_distribution<float> xVelocityDist( MIN_X_VELOCITY, MAX_X_VELOCITY );
+	std::uniform_real_distribution<float> yVelocityDist( MIN_Y_VELOCITY, MAX_Y_VELOCITY );
 	// Random Rotation
-	static std::uniform_real_distribution<float> rotationDist( MIN_ROT, MAX_ROT );
+	std::uniform_real_distribution<float> rotationDist( MIN_ROT, MAX_ROT );
 	// Random Size
-	static std::uniform_int_distribution<int> sizeDist( MIN_SIZE, MAX_SIZE );
+	std::uniform_int_distribution<int> sizeDist( mScenario.mMinSize, mScenario.mMaxSize );
 
 	glm::vec2 pos; 
 	glm::vec2 vel; 
 	
-	int maxAsteroids = asteroidsDist(rng);
+	int maxAsteroids = asteroidsDist( mRng );
+	mAsteroidsMap.reserve( mAsteroidsMap.size() + maxAsteroids );
 
 	for ( int i = 0; i < maxAsteroids; ++i )
 	{
-		pos.x = screenWidthDist( rng );
-		pos.y = screenHeightDist( rng );
-		vel.x = xVelocityDist( rng );
-		vel.y = yVelocityDist(rng);
-		float rot = rotationDist(rng);
-		int size = sizeDist(rng);
+		pos.x = screenWidthDist( mRng );
+		pos.y = screenHeightDist( mRng );
+		vel.x = xVelocityDist( mRng );
+		vel.y = yVelocityDist( mRng );
+		float rot = rotationDist( mRng );
+		int size = sizeDist( mRng );
 		AddAsteroid( SpaceObject( pos, vel, rot, size ) );
 	}
 
@@ -344,46 +680,104 @@ void Game::AddRandomAsteroids()
 
 void Game::RestartGame()
 {
-	mShip = new Ship( { 400.f, 500.f }, { 0, 255, 0, 255 } );
+	ALLOCATION_TAG( "Restart" );
+	Uint64 restartStart = SDL_GetPerformanceCounter();
 
-	mTimer = new Timer();
-	mTimer->Start();
+	// The ship, the clock and the texts are created once, then reset in place
+	if ( mShip == nullptr )
+	{
+		mShip = new Ship( SHIP_START_POSITION, { 0, 255, 0, 255 } );
+	}
+	else
+	{
+		mShip->Reset( SHIP_START_POSITION );
+	}
+	mShip->SetAutopilot( mScenario.mAutopilot );
+	mShip->SetFireRate( mScenario.mFireRate );
+	mShip->SetInvincible( mScenario.mInvincible );
 
-	const char* winText = "You WON!";
-	mWinText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( winText, 30, SDL_Color( 255, 255, 255, 255 ) ), TextRendererDeleter() );
-	mWinText->CreateText();
-	
-	const char* deadText = "You Are DEAD!";
-	mDeadText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( deadText, 26, SDL_Color( 255, 255, 255, 255 ) ), TextRendererDeleter() );
-	mDeadText->CreateText();
+	if ( mTimer == nullptr )
+	{
+		mTimer = new Timer();
+	}
+	mTimer->Start();
+	mTicksCount = 0;
+	mSimTime = 0.0;
 
-	const char* restartText = "Press enter to Restart or escape to exit.";
-	mRestartText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( restartText, 20, SDL_Color( 255, 255, 255, 255 ) ), TextRendererDeleter() );
-	mRestartText->CreateText();
+	// The timers of the last game are dropped, timed scenarios quit on their own
+	mTimerWheel.Clear();
+	if ( mScenario.mDuration > 0.f )
+	{
+		mTimerWheel.Schedule( static_cast< uint64_t >( mScenario.mDuration * 1000.0 ), [ this ]() { Quit(); } );
+	}
 
-	mScoreStr = "Score: " + std::to_string( mScoreCount );
-	mScoreText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( mScoreStr.c_str(), 20, SDL_Color( 255, 0, 0, 255 ) ), TextRendererDeleter() );
-	mScoreText->CreateText();
+	if ( mWinText == nullptr )
+	{
+		const char* winText = "You WON!";
+		mWinText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( winText, 30, SDL_Color( 255, 255, 255, 255 ) ), TextRendererDeleter() );
+		mWinText->CreateText();
+
+		const char* deadText = "You Are DEAD!";
+		mDeadText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( deadText, 26, SDL_Color( 255, 255, 255, 255 ) ), TextRendererDeleter() );
+		mDeadText->CreateText();
+
+		const char* restartText = "Press enter to Restart or escape to exit.";
+		mRestartText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( restartText, 20, SDL_Color( 255, 255, 255, 255 ) ), TextRendererDeleter() );
+		mRestartText->CreateText();
+
+		mScoreStr = "Score: 0";
+		mScoreText = std::unique_ptr<TextRenderer, TextRendererDeleter>( new TextRenderer( mScoreStr.c_str(), 20, SDL_Color( 255, 0, 0, 255 ) ), TextRendererDeleter() );
+		mScoreText->CreateText();
+		mRenderedScore = 0;
+	}
 
+	// The score text is only rebuilt by Render if the last game scored
 	mScoreCount = 0;
 	mAsteroidsIndex = 0;
 	mPlayerWon = false;
 
-	mAsteroidsMap.clear();
+	// The asteroids' nodes are kept for the new asteroids
+	while ( !mAsteroidsMap.empty() )
+	{
+		RemoveAsteroid( mAsteroidsMap.begin() );
+	}
 
+	// A fixed seed rebuilds the same asteroids on every restart
+	mRng.seed( mScenario.mSeed != 0 ? mScenario.mSeed : std::random_device{}( ) );
 	AddRandomAsteroids();
 
-	std::string startGameSoundSrc = std::string( SOLUTION_DIR ) + "Assets/RestartGame.wav";
-	mStartGameSound = Mix_LoadWAV( startGameSoundSrc.c_str() );
-	if ( !mStartGameSound )
+	if ( mStartGameSound == INVALID_SOUND )
 	{
-		printf( "Failed to load the asteroid hit sound! , Error: %s", Mix_GetError() );
+		mStartGameSound = mAudio->LoadSound( GetStartGameSoundPath(), MIX_MAX_VOLUME / 2 );
+		if ( mStartGameSound == INVALID_SOUND )
+		{
+			printf( "Failed to load the game start sound! , Error: %s", Mix_GetError() );
+		}
 	}
 
-	Mix_VolumeChunk( mStartGameSound, MIX_MAX_VOLUME / 2 );
-	mStartGameChannel;
+	mVoices.Play( mStartGameSound, VoiceManager::PRIORITY_CRITICAL );
 
-	Mix_PlayChannel( mStartGameChannel, mStartGameSound, 0 );
+	mLastRestartTime = FrameTimings::ElapsedMs( restartStart );
+	if ( mLogRestarts )
+	{
+		auto assets = AssetCache::get();
+		printf( "Restart (%s, %zu asteroids) took %.3f ms (assets: %d hits, %d misses, %zu bytes resident)\n",
+				mScenario.mName.c_str(), mAsteroidsMap.size(), mLastRestartTime, assets->GetHitCount(), assets->GetMissCount(), assets->GetResidentBytes() );
+	}
+
+	// Every restart rebuilds the same world, so the live bytes shouldn't keep growing across restarts
+	if ( AllocationTracker::IsEnabled() )
+	{
+		int64_t liveBytes = AllocationTracker::GetLiveBytes();
+		mRestartGrowth = ( mRestartLiveBytes >= 0 ) ? liveBytes - mRestartLiveBytes : 0;
+		mRestartLiveBytes = liveBytes;
+		mRestartGrowthStreak = ( mRestartGrowth > 0 ) ? mRestartGrowthStreak + 1 : 0;
+		if ( mRestartGrowthStreak >= RESTART_GROWTH_WARNING )
+		{
+			printf( "Live memory grew on the last %d restarts (%lld bytes live, +%lld since the previous restart), something leaks!\n",
+					mRestartGrowthStreak, static_cast< long long >( liveBytes ), static_cast< long long >( mRestartGrowth ) );
+		}
+	}
 }
 
 
@@ -1,4 +1,8 @@
 #pragma once
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
@@ -8,9 +12,29 @@
 #include <SDL2/SDL_ttf.h>
 
 #include "TextRenderer.hpp"
+#include "AssetCache.hpp"
+#include "AsyncLoader.hpp"
+#include "VoiceManager.hpp"
+#include "SdlMixerAudioBackend.hpp"
+#include "NullAudioBackend.hpp"
 #include "SpaceObject.h"
 #include "Asteroid.h"
+#include "Kinematics.h"
+#include "Broadphase.h"
+#include "JobSystem.hpp"
+#include "TripleBuffer.hpp"
+#include "RenderSnapshot.h"
+#include "LineBatcher.hpp"
+#include "CircleAtlas.hpp"
+#include "Transform2D.h"
 #include "Timer.h"
+#include "TimerWheel.hpp"
+#include "Scenario.h"
+#include "FrameTimings.h"
+#include "AllocationTracker.hpp"
+#include "PerfHud.h"
+#include "InputLatency.h"
+#include "FramePacer.hpp"
 #include "Ship.h"
 
 // The Window's width
@@ -34,8 +58,9 @@ public:
 
 	/**
 	* @brief Initializes the game, and it's objects
+	* @param headless Renders into an offscreen software renderer, without a window on screen or an audio device
 	*/
-	bool Init( const char* title, bool fullscreen );
+	bool Init( const char* title, bool fullscreen, bool headless = false );
 
 	/**
 	* @brief Quits the game, sets mIsRunnning to false
@@ -48,7 +73,7 @@ public:
 	void Update();
 	
 	/**
-	* @brief Renders the game's objects
+	* @brief Renders the game's objects, from the latest render snapshot published by Update
 	*/
 	void Render();
 	
@@ -63,9 +88,15 @@ public:
 	void ProcessInput();
 
 	/**
-	* @brief Starts the game's main loop
+	* @brief Starts the game's main loop (runs frames until the game quits)
 	*/
 	void RunGame();
+
+	/**
+	* @brief Runs a single frame of the main loop (a loading screen frame while the assets load).
+	* The simulation tick runs as a job while this thread renders the previous tick's snapshot.
+	*/
+	void RunFrame();
 	
 	/// Getters
 	///--------------------------------------------------------
@@ -94,26 +125,153 @@ public:
 	 */
 	float GetDeltaTime() { return mDeltaTime; }
 
+	/**
+	 * @brief Returns the simulated time since the last restart, in seconds
+	 */
+	double GetSimTime() const { return mSimTime; }
+
+	/**
+	 * @brief Makes every update advance by a fixed time step instead of the elapsed time (0 goes back to the elapsed time)
+	 */
+	void SetFixedTimeStep( float seconds ) { mFixedTimeStep = seconds; }
+
+	/**
+	 * @brief Checks if the assets are still loading (the loading screen is shown)
+	 */
+	bool IsLoading() const { return mLoader != nullptr; }
+
+	/**
+	 * @brief Returns how long the phases of the last frame took
+	 */
+	const FrameTimings& GetFrameTimings() const { return mFrameTimings; }
+
+	/**
+	 * @brief Returns the number of SDL draw calls issued by the last rendered frame
+	 */
+	int GetDrawCallCount() const { return mDrawCallCount; }
+
+	/**
+	 * @brief Returns how long the last RestartGame() took, in milliseconds
+	 */
+	double GetLastRestartTime() const { return mLastRestartTime; }
+
+	/**
+	 * @brief Returns the allocations made by the last frame, per tag (all 0 without ASTEROIDS_TRACK_ALLOCATIONS)
+	 */
+	const AllocationTracker::Snapshot& GetFrameAllocations() const { return mFrameAllocations; }
+
+	/**
+	 * @brief Returns how many more live bytes the last RestartGame() left than the one before (0 after the first)
+	 */
+	int64_t GetRestartGrowth() const { return mRestartGrowth; }
+
+	/**
+	 * @brief Returns the input to photon latency recorder (see InputLatency.h)
+	 */
+	InputLatency& GetInputLatency() { return mInputLatency; }
+
+	/**
+	 * @brief Returns the frame pacer: its mode can be set before Init (the renderer is created with or without
+	 * vsync, Init reads ASTEROIDS_PRESENT over it) or switched at runtime (F4 cycles the modes).
+	 */
+	FramePacer& GetFramePacer() { return mFramePacer; }
+
+	/**
+	 * @brief Returns the game's timer wheel: its ticks are the simulated milliseconds since the last restart, and
+	 * its callbacks run on the main thread between frames. RestartGame() cancels every timer.
+	 */
+	TimerWheel& GetTimerWheel() { return mTimerWheel; }
+
+	/**
+	 * @brief Returns the game's line batcher (every wire frame is drawn through it)
+	 */
+	LineBatcher& GetLineBatcher() { return mLineBatcher; }
+
+	/**
+	 * @brief Returns the game's voice manager (every sound is played through it)
+	 */
+	VoiceManager& GetVoiceManager() { return mVoices; }
+
+	/**
+	 * @brief Returns the audio backend the sounds are loaded and played through
+	 */
+	IAudioBackend& GetAudioBackend() { return *mAudio; }
+
+	/**
+	 * @brief Sets the audio backend the sounds are loaded and played through (Init picks one)
+	 */
+	void SetAudioBackend( std::unique_ptr<IAudioBackend> audio );
+
+	/**
+	 * @brief Sets the scenario the next RestartGame() builds (the classic game by default)
+	 */
+	void SetScenario( const Scenario& scenario ) { mScenario = scenario; }
+
+	/**
+	 * @brief Returns the scenario the game is built from
+	 */
+	const Scenario& GetScenario() const { return mScenario; }
+
 	/**
 	 * @brief Returns the game's asteroids map (unordered)
 	 */
 	std::unordered_map<int, Asteroid>& GetAsteroidsMap() { return mAsteroidsMap; }
 
+	/**
+	 * @brief Returns the map key of the asteroid at an index of this frame's asteroids broadphase.
+	 */
+	int GetAsteroidId( int index ) const { return mAsteroidIds[ index ]; }
+
+	/**
+	 * @brief Returns the asteroids packed by the last PackAsteroids() call
+	 */
+	const KinematicsBatch& GetAsteroidKinematics() const { return mAsteroidKinematics; }
+
+	/**
+	 * @brief Returns the grid the bullets and the ship are checked against
+	 */
+	Broadphase& GetAsteroidBroadphase() { return mAsteroidBroadphase; }
+
+	/**
+	 * @brief Returns the game's job system
+	 */
+	JobSystem* GetJobSystem() { return mJobSystem.get(); }
+
+	/**
+	 * @brief Returns the performance overlay
+	 */
+	PerfHud& GetPerfHud() { return mPerfHud; }
+
 	/// Utility
 	///--------------------------------------------------------
 
 	/**
-	 * @brief Draws a wire frame (an outline shape) type of model with the given the coordinates.
-	 * @param renderer The renderer that handles the draw call
+	 * @brief Queues a wire frame (an outline shape) type of model with the given the coordinates in the line batch.
+	 * The model is drawn when the line batch is flushed (once per frame, see Render).
 	 * @param vecModelCoordinates The model's vertices to be drawn. 
 	 * Each pair of floats in the vector represents the X and Y coordinates of a vertex in the model.
 	 * @param x The x position where the model should be drawn on the screen
 	 * @param y The y position where the model should be drawn on the screen
-	 * @param r The Model's rotation (in RAD), has a default value of 0.
-	 * @param s The Model's scale(or size), has a default value of 1.0f.
+	 * @param r The Model's rotation (in RAD).
+	 * @param s The Model's scale(or size).
+	 * @param color The Model's color.
 	*/
-	void DrawWireFrameModel( SDL_Renderer* renderer, const std::vector<std::pair<float, float>>& vecModelCoordinates,
-							 float x, float y, float r = 0.0f, float s = 1.0f );
+	void DrawWireFrameModel( const std::vector<std::pair<float, float>>& vecModelCoordinates,
+							 float x, float y, float r, float s, const SDL_Color& color );
+
+	/**
+	 * @brief Transforms (rotates, scales and translates) a wire frame model's vertices, without drawing them.
+	 * The rotation, scale and translation are fused into one affine matrix, applied in a single SIMD pass.
+	 * Doesn't touch the renderer, so models can be transformed in parallel.
+	 * @param vecModelCoordinates The model's vertices.
+	 * @param x The x position of the model
+	 * @param y The y position of the model
+	 * @param r The Model's rotation (in RAD).
+	 * @param s The Model's scale(or size).
+	 * @param outPoints Receives the transformed vertices, must have room for every model vertex.
+	*/
+	static void TransformWireFrameModel( const std::vector<std::pair<float, float>>& vecModelCoordinates,
+										 float x, float y, float r, float s, SDL_FPoint* outPoints );
 
 	/**
 	 * @brief Wraps coordinates to ensure continuous movement within game space.
@@ -123,14 +281,13 @@ public:
 	void WrapCoordinates( SpaceObject& obj );
 
 	/**
-	 * @brief Draws a filled circle
-	 * @param renderer The renderer that handles the draw call
+	 * @brief Queues a filled circle, drawn from a cached sprite when the circle batch is flushed
 	 * @param centerX The circle's center x position
 	 * @param centerY The circle's center y position
 	 * @param radius The circle's radius
 	 * @param color The circle's color
 	*/
-	void DrawCircleFill( SDL_Renderer* renderer, float centerX, float centerY, float radius, SDL_Color color );
+	void DrawCircleFill( float centerX, float centerY, float radius, SDL_Color color );
 
 	/**
 	 * @brief Checks if a given point is inside a circle
@@ -148,24 +305,59 @@ public:
 	 * @param obj The asteroid's space object
 	*/
 	void AddAsteroid( const SpaceObject& obj );
+
+	/**
+	 * @brief Removes an asteroid from the game.
+	 * The asteroid's map node is kept, the next AddAsteroid reuses it instead of allocating one.
+	 * @param asteroid The asteroid's iterator in the asteroids map (invalidated)
+	*/
+	void RemoveAsteroid( std::unordered_map<int, Asteroid>::iterator asteroid );
 	
 	/**
 	 * @brief Adds random asteroids to the game.
-	 * The asteroids position, velocity, rotation and size are being randomized
+	 * The asteroids count and size ranges come from the scenario, their position, velocity, rotation and size are randomized
 	*/
 	void AddRandomAsteroids();
 
+	/**
+	 * @brief Packs the asteroids map into the asteroids kinematics batch (and their ids, see GetAsteroidId).
+	*/
+	void PackAsteroids();
+
 	/**
 	 * @brief Resets the game to it's initial state.
+	 * The first call creates the ship, the clock and the texts, the next ones reset them in place
+	 * (the ship's bullets and the asteroids' map nodes are reused, the loaded assets are kept).
 	*/
 	void RestartGame();
 
+	/**
+	 * @brief Sets whether RestartGame() prints its duration (off by default, ASTEROIDS_LOG_RESTARTS turns it on).
+	*/
+	void SetLogRestarts( bool logRestarts ) { mLogRestarts = logRestarts; }
+
 	/**
 	 * @brief Adds 1 to the player's score.
 	 */
 	void AddScore( int score ) { mScoreCount += score; }
 
 private:
+	/**
+	 * @brief Runs a loading screen frame while the assets load in the background.
+	 * @return true once every asset is loaded and the game was started.
+	 */
+	bool UpdateLoading();
+
+	/**
+	 * @brief Hands this frame's presses to the input latency recorder, tagged with the tick consuming them.
+	 */
+	void RecordInputLatency();
+
+	/**
+	 * @brief Copies the state the renderer needs into the render snapshots write buffer, and publishes it.
+	 */
+	void WriteRenderSnapshot();
+
 	// Game's private constructor
 	// Follows the singleton design pattern
 	Game()
@@ -175,10 +367,8 @@ private:
 		, mShip( nullptr )
 		, mTimer( nullptr )
 		, mDeltaTime( 0.0f )
-		, mFPS( 0.0 )
 		, mTicksCount( 0 )
 		, mAsteroidsIndex( 0 )
-		, mStartGameSound( nullptr )
 		, mScoreCount( 0 )
 		, mPlayerWon( false )
 	{}
@@ -197,12 +387,81 @@ private:
 
 	// Map to hold the game's asteroids
 	std::unordered_map<int, Asteroid> mAsteroidsMap;
+	// Nodes of the removed asteroids, reused by AddAsteroid
+	std::vector<std::unordered_map<int, Asteroid>::node_type> mFreeAsteroidNodes;
+	// Packed asteroids kinematics, refilled and integrated every frame
+	KinematicsBatch mAsteroidKinematics;
+	// Map keys of the asteroids in mAsteroidKinematics (same order)
+	std::vector<int> mAsteroidIds;
+	// Grid of the asteroids (before they move), the bullets and the ship are checked against it
+	Broadphase mAsteroidBroadphase;
+
+	// Runs the frame's update and render phases across the cpu cores
+	std::unique_ptr<JobSystem> mJobSystem;
+	// Loads the assets in the background after Init, null once the game started
+	std::unique_ptr<AsyncLoader> mLoader;
+
+	// Render snapshots, written by the simulation and read by the renderer
+	TripleBuffer<RenderSnapshot> mRenderSnapshots;
+	// The score the score text was last rendered with (-1 forces a refresh)
+	int mRenderedScore = -1;
+
+	// Line batch slots of the asteroids rendered this frame
+	std::vector<LinePolygonSlot> mAsteroidSlots;
+
+	// Batches the frame's wire frames into a few draw calls
+	LineBatcher mLineBatcher;
+	// Pre-rasterized circle sprites, the frame's circles (bullets) are drawn in one call
+	CircleAtlas mCircleAtlas;
+	// SDL draw calls issued by the frame being rendered (or the last one)
+	int mDrawCallCount = 0;
 
 	// The player's ship object
 	Ship* mShip;
 
 	// the Game's timer
 	Timer* mTimer;
+	// Gameplay timers, driven by the simulated time
+	TimerWheel mTimerWheel;
+
+	// The world RestartGame() builds
+	Scenario mScenario;
+	// Randomizes the asteroids, reseeded from the scenario on every restart
+	std::mt19937 mRng;
+
+	// The ticks simulated since Init, the render snapshots carry the tick that wrote them
+	uint64_t mTickIndex = 0;
+	// Seconds simulated since the last restart
+	double mSimTime = 0.0;
+	// Fixed update time step in seconds, 0 uses the elapsed time
+	float mFixedTimeStep = 0.f;
+	// The last frame's phase timings
+	FrameTimings mFrameTimings;
+	// Bullet/asteroid pairs tested by the last update
+	std::atomic<int> mCollisionPairs{ 0 };
+	// The performance overlay (toggled with F3)
+	PerfHud mPerfHud;
+
+	// Paces the frames (vsync, uncapped or limited)
+	FramePacer mFramePacer;
+	// Records the input to photon latency (ASTEROIDS_LATENCY)
+	InputLatency mInputLatency;
+
+	// Duration of the last RestartGame() call, in milliseconds
+	double mLastRestartTime = 0.0;
+	// Whether RestartGame() prints its duration
+	bool mLogRestarts = false;
+
+	// Restarts in a row growing the live bytes before a leak is reported
+	static const int RESTART_GROWTH_WARNING = 3;
+	// The last frame's allocations
+	AllocationTracker::Snapshot mFrameAllocations;
+	// Live bytes left by the last RestartGame() call, -1 before the first one
+	int64_t mRestartLiveBytes = -1;
+	// Live bytes growth between the last two RestartGame() calls
+	int64_t mRestartGrowth = 0;
+	// Number of RestartGame() calls in a row that grew the live bytes
+	int mRestartGrowthStreak = 0;
 
 	// The Game's tick count
 	uint64_t mTicksCount;
@@ -210,12 +469,6 @@ private:
 	float mDeltaTime;
 	// Holds the score text to be rendered
 	std::string mScoreStr;
-	// Holds the game's fps text 
-	std::string mFPSText;
-	// The Game's fps
-	long double mFPS;
-	// Renders the fps text
-	//std::unique_ptr<TextRenderer, TextRendererDeleter> mFpsText;
 	// Renders the win text
 	std::unique_ptr<TextRenderer, TextRendererDeleter> mWinText;
 	// Renders the dead text
@@ -231,14 +484,6 @@ private:
 	// Asteroids map index
 	int mAsteroidsIndex;
 
-	// Minimum asteroids count
-	static const int MIN_ASTEROIDS_COUNT = 15;
-	// Maximum asteroids count
-	static const int MAX_ASTEROIDS_COUNT = 35;
-	// Minimum asteroids size
-	static const int MIN_SIZE = 24;
-	// Minimum asteroids size
-	static const int MAX_SIZE = 96;
 	// Minimum asteroids x velocity
 	static const float MIN_X_VELOCITY;
 	// Maximum asteroids x velocity
@@ -251,10 +496,25 @@ private:
 	static const float MIN_ROT;
 	// Maximum asteroids rotation
 	static const float MAX_ROT;
+	// Where the ship starts every game
+	static const glm::vec2 SHIP_START_POSITION;
+
+	// Asteroids inserted in the broadphase grid per job
+	static const int BROADPHASE_GRAIN_SIZE = 1024;
+	// Asteroids integrated per job
+	static const int KINEMATICS_GRAIN_SIZE = 1024;
+	// Bullets checked for collision per job
+	static const int COLLISION_GRAIN_SIZE = 256;
+	// Asteroids wire frames transformed per job
+	static const int RENDER_GRAIN_SIZE = 128;
 
 	// Game Start Sound
-	Mix_Chunk* mStartGameSound;
-	// Game start sound channel
-	int mStartGameChannel = 0;
+	SoundHandle mStartGameSound = INVALID_SOUND;
+
+	// Plays the game's sounds (SDL_mixer, or the null backend without an audio device)
+	std::unique_ptr<IAudioBackend> mAudio;
+
+	// Allocates the mixer channels to the frame's sounds
+	VoiceManager mVoices;
 };
 
@@ -0,0 +1,165 @@
+#include "GlyphAtlas.hpp"
+
+#include <cstdio>
+
+namespace venture
+{
+	namespace
+	{
+		// Glyphs are packed in rows no wider than this
+		const int MAX_ATLAS_WIDTH = 512;
+	}
+
+	bool GlyphAtlas::Create( SDL_Renderer* renderer, TTF_Font* font )
+	{
+		Clean();
+
+		if ( font == nullptr )
+		{
+			return false;
+		}
+
+		// Rasterize every glyph in white, the text color is applied through the vertices
+		const SDL_Color white = { 255, 255, 255, 255 };
+		std::array<SDL_Surface*, LAST_GLYPH - FIRST_GLYPH + 1> surfaces = {};
+
+		// Pack the glyphs in rows, 1 pixel apart
+		int penX = 0;
+		int penY = 0;
+		int rowHeight = 0;
+		int atlasWidth = 0;
+		for ( int c = FIRST_GLYPH; c <= LAST_GLYPH; ++c )
+		{
+			Glyph& glyph = mGlyphs[ c - FIRST_GLYPH ];
+			int minX, maxX, minY, maxY;
+			if ( TTF_GlyphMetrics( font, static_cast< Uint16 >( c ), &minX, &maxX, &minY, &maxY, &glyph.mAdvance ) != 0 )
+			{
+				glyph.mAdvance = 0;
+			}
+
+			SDL_Surface* surface = TTF_RenderGlyph_Solid( font, static_cast< Uint16 >( c ), white );
+			surfaces[ c - FIRST_GLYPH ] = surface;
+			if ( surface == nullptr )
+			{
+				glyph.mRect = { 0, 0, 0, 0 };
+				continue;
+			}
+
+			if ( penX + surface->w > MAX_ATLAS_WIDTH )
+			{
+				penX = 0;
+				penY += rowHeight + 1;
+				rowHeight = 0;
+			}
+
+			glyph.mRect = { penX, penY, surface->w, surface->h };
+			penX += surface->w + 1;
+			if ( surface->h > rowHeight )
+			{
+				rowHeight = surface->h;
+			}
+			if ( penX > atlasWidth )
+			{
+				atlasWidth = penX;
+			}
+		}
+		int atlasHeight = penY + rowHeight;
+
+		bool success = false;
+		SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat( 0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32 );
+		if ( atlas == nullptr )
+		{
+			printf( "Failed to create the glyph atlas surface! Error: %s\n", SDL_GetError() );
+		}
+		else
+		{
+			// The surface starts fully transparent, the glyphs background is color keyed out
+			SDL_FillRect( atlas, nullptr, 0 );
+			for ( int c = FIRST_GLYPH; c <= LAST_GLYPH; ++c )
+			{
+				if ( surfaces[ c - FIRST_GLYPH ] != nullptr )
+				{
+					SDL_Rect destination = mGlyphs[ c - FIRST_GLYPH ].mRect;
+					SDL_BlitSurface( surfaces[ c - FIRST_GLYPH ], nullptr, atlas, &destination );
+				}
+			}
+
+			mTexture.reset( SDL_CreateTextureFromSurface( renderer, atlas ) );
+			if ( mTexture == nullptr )
+			{
+				printf( "Failed to create the glyph atlas texture! Error: %s\n", SDL_GetError() );
+			}
+			else
+			{
+				SDL_SetTextureBlendMode( mTexture.get(), SDL_BLENDMODE_BLEND );
+				mSize = glm::ivec2( atlasWidth, atlasHeight );
+				mLineHeight = TTF_FontHeight( font );
+				success = true;
+			}
+			SDL_FreeSurface( atlas );
+		}
+
+		for ( SDL_Surface* surface : surfaces )
+		{
+			SDL_FreeSurface( surface );
+		}
+		return success;
+	}
+
+	void GlyphAtlas::Clean()
+	{
+		mTexture.reset();
+		mSize = glm::ivec2();
+		mLineHeight = 0;
+	}
+
+	glm::ivec2 GlyphAtlas::LayoutText( const std::string& text, float x, float y, const SDL_Color& color,
+									   std::vector<SDL_Vertex>& vertices, std::vector<int>& indices ) const
+	{
+		if ( mTexture == nullptr )
+		{
+			return glm::ivec2();
+		}
+
+		const float invWidth = 1.f / mSize.x;
+		const float invHeight = 1.f / mSize.y;
+
+		float penX = x;
+		for ( char c : text )
+		{
+			if ( c < FIRST_GLYPH || c > LAST_GLYPH )
+			{
+				continue;
+			}
+
+			const Glyph& glyph = mGlyphs[ c - FIRST_GLYPH ];
+			if ( glyph.mRect.w > 0 )
+			{
+				float x0 = penX;
+				float y0 = y;
+				float x1 = x0 + glyph.mRect.w;
+				float y1 = y0 + glyph.mRect.h;
+				float u0 = glyph.mRect.x * invWidth;
+				float v0 = glyph.mRect.y * invHeight;
+				float u1 = ( glyph.mRect.x + glyph.mRect.w ) * invWidth;
+				float v1 = ( glyph.mRect.y + glyph.mRect.h ) * invHeight;
+
+				int first = static_cast< int >( vertices.size() );
+				vertices.push_back( { { x0, y0 }, color, { u0, v0 } } );
+				vertices.push_back( { { x1, y0 }, color, { u1, v0 } } );
+				vertices.push_back( { { x0, y1 }, color, { u0, v1 } } );
+				vertices.push_back( { { x1, y1 }, color, { u1, v1 } } );
+
+				indices.push_back( first );
+				indices.push_back( first + 1 );
+				indices.push_back( first + 2 );
+				indices.push_back( first + 1 );
+				indices.push_back( first + 3 );
+				indices.push_back( first + 2 );
+			}
+			penX += glyph.mAdvance;
+		}
+
+		return glm::ivec2( static_cast< int >( penX - x ), mLineHeight );
+	}
+}
@@ -0,0 +1,103 @@
+/**
+ * @class GlyphAtlas
+ * @brief The printable ASCII glyphs of a font, rasterized once into a single texture.
+ *
+ * Glyphs are rendered in white, so one atlas serves every text color: the color is
+ * applied through the vertices. Text is laid out as one textured quad per character,
+ * and a whole string is drawn with a single SDL_RenderGeometry call.
+ *
+ * Example usage:
+ * @code
+ * venture::GlyphAtlas atlas;
+ * atlas.Create( renderer, font );
+ * std::vector<SDL_Vertex> vertices;
+ * std::vector<int> indices;
+ * atlas.LayoutText( "Score: 10", 10.f, 20.f, color, vertices, indices );
+ * SDL_RenderGeometry( renderer, atlas.GetTexture(), vertices.data(), ..., indices.data(), ... );
+ * @endcode
+ */
+
+#pragma once
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "Texture.hpp"
+
+namespace venture
+{
+	class GlyphAtlas
+	{
+	public:
+		// The first and last glyphs kept in the atlas (printable ASCII)
+		static const char FIRST_GLYPH = 32;
+		static const char LAST_GLYPH = 126;
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Rasterizes every glyph of the font into the atlas texture.
+		 * @param renderer The renderer that owns the texture.
+		 * @param font The font to rasterize.
+		 * @return true on success, false on failure.
+		 */
+		bool Create( SDL_Renderer* renderer, TTF_Font* font );
+
+		/**
+		 * @brief Releases the atlas texture.
+		 */
+		void Clean();
+
+		/**
+		 * @brief Appends a quad per character of text to the vertex and index lists (characters outside the atlas are skipped).
+		 * @param text The text to lay out.
+		 * @param x The x position of the text's top left corner.
+		 * @param y The y position of the text's top left corner.
+		 * @param color The text color.
+		 * @param vertices Receives the quads vertices.
+		 * @param indices Receives the quads indices.
+		 * @return The width and height of the laid out text.
+		 */
+		glm::ivec2 LayoutText( const std::string& text, float x, float y, const SDL_Color& color,
+							   std::vector<SDL_Vertex>& vertices, std::vector<int>& indices ) const;
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the atlas texture (null before Create()).
+		 */
+		SDL_Texture* GetTexture() const { return mTexture.get(); }
+
+		/**
+		 * @brief Returns the height of a line of text.
+		 */
+		int GetLineHeight() const { return mLineHeight; }
+
+	private:
+		// A glyph's location in the atlas
+		struct Glyph
+		{
+			// The glyph's rectangle in the atlas, in pixels
+			SDL_Rect mRect;
+			// How far the pen moves after the glyph
+			int mAdvance;
+		};
+
+	private:
+		// The atlas texture
+		std::unique_ptr<SDL_Texture, SDLTextureDeleter> mTexture;
+		// The atlas width and height
+		glm::ivec2 mSize = glm::ivec2();
+		// The glyphs, indexed by character - FIRST_GLYPH
+		std::array<Glyph, LAST_GLYPH - FIRST_GLYPH + 1> mGlyphs = {};
+		// The height of a line of text
+		int mLineHeight = 0;
+	};
+}
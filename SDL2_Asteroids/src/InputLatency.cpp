@@ -0,0 +1,112 @@
+#include "InputLatency.h"
+
+#include <algorithm>
+
+#include <SDL2/SDL.h>
+
+namespace
+{
+	// Nearest rank percentile of sorted values
+	double Percentile( const std::vector<double>& sorted, double percentile )
+	{
+		if ( sorted.empty() )
+		{
+			return 0.0;
+		}
+		std::size_t rank = static_cast< std::size_t >( percentile / 100.0 * sorted.size() + 0.5 );
+		return sorted[ std::min( sorted.size() - 1, rank > 0 ? rank - 1 : 0 ) ];
+	}
+
+	void PrintDistribution( const char* label, const char* name, const LatencyDistribution& distribution )
+	{
+		printf( "latency,%s,%s,%zu,%.3f,%.3f,%.3f,%.3f,%.3f\n", label, name, distribution.mCount, distribution.mMean,
+				distribution.mP50, distribution.mP95, distribution.mP99, distribution.mMax );
+	}
+}
+
+void InputLatency::AddInput( uint64_t tick, uint64_t pollCounter, float queueSeconds )
+{
+	if ( mEnabled )
+	{
+		mPending.push_back( { tick, pollCounter, queueSeconds } );
+	}
+}
+
+void InputLatency::AddPresent( uint64_t tick, uint64_t presentCounter )
+{
+	// The ticks only go up, the presses shown are at the front
+	std::size_t shown = 0;
+	const double counterToMs = 1000.0 / SDL_GetPerformanceFrequency();
+	while ( shown < mPending.size() && mPending[ shown ].mTick <= tick )
+	{
+		const PendingInput& input = mPending[ shown ];
+		InputLatencySample sample;
+		sample.mTick = input.mTick;
+		sample.mQueueMs = input.mQueueSeconds * 1000.0;
+		sample.mPresentMs = static_cast< double >( presentCounter - input.mPollCounter ) * counterToMs;
+		sample.mTotalMs = sample.mQueueMs + sample.mPresentMs;
+		mSamples.push_back( sample );
+		++shown;
+	}
+	mPending.erase( mPending.begin(), mPending.begin() + shown );
+}
+
+void InputLatency::Clear()
+{
+	mPending.clear();
+	mSamples.clear();
+}
+
+LatencyDistribution InputLatency::GetDistribution( double InputLatencySample::* latency ) const
+{
+	LatencyDistribution distribution;
+	if ( mSamples.empty() )
+	{
+		return distribution;
+	}
+
+	std::vector<double> values;
+	values.reserve( mSamples.size() );
+	double sum = 0.0;
+	for ( const InputLatencySample& sample : mSamples )
+	{
+		values.push_back( sample.*latency );
+		sum += sample.*latency;
+	}
+	std::sort( values.begin(), values.end() );
+
+	distribution.mCount = values.size();
+	distribution.mMean = sum / values.size();
+	distribution.mP50 = Percentile( values, 50.0 );
+	distribution.mP95 = Percentile( values, 95.0 );
+	distribution.mP99 = Percentile( values, 99.0 );
+	distribution.mMax = values.back();
+	return distribution;
+}
+
+void InputLatency::PrintSummary( const char* label ) const
+{
+	printf( "latency,mode,phase,presses,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n" );
+	PrintDistribution( label, "queue", GetDistribution( &InputLatencySample::mQueueMs ) );
+	PrintDistribution( label, "present", GetDistribution( &InputLatencySample::mPresentMs ) );
+	PrintDistribution( label, "total", GetDistribution( &InputLatencySample::mTotalMs ) );
+}
+
+bool InputLatency::WriteCsv( const char* path, const char* label ) const
+{
+	FILE* file = fopen( path, "w" );
+	if ( file == nullptr )
+	{
+		printf( "Failed to write the input latency to %s!\n", path );
+		return false;
+	}
+
+	fprintf( file, "mode,tick,queue_ms,present_ms,total_ms\n" );
+	for ( const InputLatencySample& sample : mSamples )
+	{
+		fprintf( file, "%s,%llu,%.3f,%.3f,%.3f\n", label, static_cast< unsigned long long >( sample.mTick ),
+				 sample.mQueueMs, sample.mPresentMs, sample.mTotalMs );
+	}
+	fclose( file );
+	return true;
+}
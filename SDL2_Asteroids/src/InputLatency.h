@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Input to photon latency: how long a press takes to show on screen.
+// Every press (key or mouse button down) is stamped when SDL_PollEvent returns it, tagged with the
+// simulation tick that consumes it, and resolved when the first frame drawn from that tick (or a later
+// one) is presented. The renderer draws the previous tick's snapshot while the next tick simulates
+// (see Game::RunFrame), so a press usually shows one frame after the frame that polled it.
+// The "photon" is SDL_RenderPresent returning: the display's own latency (scan-out, panel) isn't included.
+
+/**
+ * @brief A press, from the OS to the screen
+ */
+struct InputLatencySample
+{
+	// The simulation tick that consumed the press
+	uint64_t mTick = 0;
+	// In the OS event queue, from the event's SDL timestamp to SDL_PollEvent (millisecond precision)
+	double mQueueMs = 0.0;
+	// From SDL_PollEvent to the present of the first frame showing the press
+	double mPresentMs = 0.0;
+	// Both of the above
+	double mTotalMs = 0.0;
+};
+
+/**
+ * @brief A latency's distribution over the samples, in milliseconds
+ */
+struct LatencyDistribution
+{
+	std::size_t mCount = 0;
+	double mMean = 0.0;
+	double mP50 = 0.0;
+	double mP95 = 0.0;
+	double mP99 = 0.0;
+	double mMax = 0.0;
+};
+
+class InputLatency
+{
+public:
+	/// Utility
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Starts or stops recording (off by default, Game::Init turns it on when ASTEROIDS_LATENCY is set).
+	 */
+	void SetEnabled( bool enabled ) { mEnabled = enabled; }
+
+	/**
+	 * @brief Records a press consumed by a tick.
+	 * @param tick The tick that consumes the press
+	 * @param pollCounter SDL_GetPerformanceCounter() when SDL_PollEvent returned the press
+	 * @param queueSeconds How long the press waited in the OS queue (see InputManager::GetEventAge)
+	 */
+	void AddInput( uint64_t tick, uint64_t pollCounter, float queueSeconds );
+
+	/**
+	 * @brief Resolves the presses shown by a presented frame.
+	 * @param tick The tick the frame was drawn from (see RenderSnapshot::mTick)
+	 * @param presentCounter SDL_GetPerformanceCounter() when SDL_RenderPresent returned
+	 */
+	void AddPresent( uint64_t tick, uint64_t presentCounter );
+
+	/**
+	 * @brief Drops the samples and the pending presses.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Prints the queue, present and total distributions on one line each.
+	 * @param label Names the configuration measured (e.g. the present mode)
+	 */
+	void PrintSummary( const char* label ) const;
+
+	/**
+	 * @brief Writes every sample as CSV.
+	 * @return false if the file couldn't be written.
+	 */
+	bool WriteCsv( const char* path, const char* label ) const;
+
+	/// Getters
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Checks if the presses are recorded.
+	 */
+	bool IsEnabled() const { return mEnabled; }
+
+	/**
+	 * @brief Returns the resolved presses, oldest first.
+	 */
+	const std::vector<InputLatencySample>& GetSamples() const { return mSamples; }
+
+	/**
+	 * @brief Returns the number of presses waiting for their frame to be presented.
+	 */
+	std::size_t GetPendingCount() const { return mPending.size(); }
+
+	/**
+	 * @brief Returns the distribution of one of the samples' latencies.
+	 * @param latency The latency, e.g. &InputLatencySample::mTotalMs
+	 */
+	LatencyDistribution GetDistribution( double InputLatencySample::* latency ) const;
+
+private:
+	/**
+	 * @brief A press waiting for its frame
+	 */
+	struct PendingInput
+	{
+		uint64_t mTick;
+		uint64_t mPollCounter;
+		float mQueueSeconds;
+	};
+
+	// Whether the presses are recorded
+	bool mEnabled = false;
+	// Presses consumed by ticks that weren't presented yet, in tick order
+	std::vector<PendingInput> mPending;
+	// Resolved presses
+	std::vector<InputLatencySample> mSamples;
+};
@@ -1,90 +1,199 @@
 #include "InputManager.hpp"
 #include "Game.h"
 
+#include <algorithm>
+
 namespace venture
 {
 	InputManager* InputManager::s_Instance = nullptr;
 
+	namespace
+	{
+		uint32_t GetButtonMask( MouseButton button )
+		{
+			switch ( button )
+			{
+			case MouseButton::LEFT:
+				return SDL_BUTTON_LMASK;
+			case MouseButton::RIGHT:
+				return SDL_BUTTON_RMASK;
+			case MouseButton::MIDDLE:
+				return SDL_BUTTON_MMASK;
+			case MouseButton::BACK:
+				return SDL_BUTTON_X1MASK;
+			case MouseButton::FORWARD:
+				return SDL_BUTTON_X2MASK;
+			}
+			return 0;
+		}
+
+		// SDL numbers the buttons left, middle, right
+		MouseButton ToMouseButton( Uint8 button )
+		{
+			switch ( button )
+			{
+			case SDL_BUTTON_RIGHT:
+				return MouseButton::RIGHT;
+			case SDL_BUTTON_MIDDLE:
+				return MouseButton::MIDDLE;
+			case SDL_BUTTON_X1:
+				return MouseButton::BACK;
+			case SDL_BUTTON_X2:
+				return MouseButton::FORWARD;
+			default:
+				return MouseButton::LEFT;
+			}
+		}
+	}
+
 	InputManager::InputManager()
-		: mMouseLock( false ), mKeyLock( false )
+		: mMouseXPos( 0 ), mMouseYPos( 0 ), mMouseLock( false ), mKeyLock( false )
 	{
-		mCurrKeyState = SDL_GetKeyboardState( &mKeyLength );
-		mPrevKeyState = new uint8_t[ mKeyLength ];
-		memcpy( mPrevKeyState, mCurrKeyState, mKeyLength );
 	}
 
 	InputManager::~InputManager()
 	{
-		delete[] mPrevKeyState;
-		mPrevKeyState = nullptr;
 	}
 
 	void InputManager::ProcessInput( SDL_Event* event )
 	{
 		auto game =Game::GetInstance();
+		// Everything queued since the last poll was injected
+		const uint64_t injectedEnd = mEventsPushed;
 		while ( SDL_PollEvent( event ) )
 		{
-			if ( event->type == SDL_QUIT )
+			InputEvent input;
+			input.mPollCounter = SDL_GetPerformanceCounter();
+			switch ( event->type )
 			{
+			case SDL_QUIT:
 				game->Quit();
+				break;
+			case SDL_KEYDOWN:
+			case SDL_KEYUP:
+				// Held keys repeat, only the first press counts
+				if ( event->key.repeat == 0 && !mInjectingKeys )
+				{
+					input.mType = ( event->type == SDL_KEYDOWN ) ? InputEventType::KEY_DOWN : InputEventType::KEY_UP;
+					input.mScancode = event->key.keysym.scancode;
+					input.mTimestamp = event->key.timestamp;
+					PushEvent( input );
+				}
+				break;
+			case SDL_MOUSEBUTTONDOWN:
+			case SDL_MOUSEBUTTONUP:
+				input.mType = ( event->type == SDL_MOUSEBUTTONDOWN ) ? InputEventType::MOUSE_BUTTON_DOWN : InputEventType::MOUSE_BUTTON_UP;
+				input.mButton = ToMouseButton( event->button.button );
+				input.mTimestamp = event->button.timestamp;
+				PushEvent( input );
+				break;
+			default:
+				break;
 			}
 		}
-		
-		mCurrMouseState = SDL_GetMouseState( &mMouseXPos, &mMouseYPos );
+		Uint32 pollTicks = SDL_GetTicks();
+
+		// The injected events were stamped relative to the last poll, they move with the poll so their age stays
+		// the one they were injected with, however long the frame between took
+		for ( uint64_t i = std::max( mPolledEvents, mFrameEventsBegin ); i < injectedEnd; ++i )
+		{
+			mEvents[ i & ( EVENT_CAPACITY - 1 ) ].mTimestamp += pollTicks - mPollTicks;
+		}
+		mPollTicks = pollTicks;
+		mPolledEvents = mEventsPushed;
+
+		SDL_GetMouseState( &mMouseXPos, &mMouseYPos );
 
 	}
 
 	void InputManager::UpdatePrevInput()
 	{
-		memcpy( mPrevKeyState, mCurrKeyState, mKeyLength );
-		mPrevMouseState = mCurrMouseState;
+		mFrameEventsBegin = mEventsPushed;
+	}
+
+	std::size_t InputManager::GetFrameEventCount() const
+	{
+		return static_cast< std::size_t >( mEventsPushed - mFrameEventsBegin );
+	}
+
+	const InputEvent& InputManager::GetFrameEvent( std::size_t index ) const
+	{
+		return mEvents[ ( mFrameEventsBegin + index ) & ( EVENT_CAPACITY - 1 ) ];
+	}
+
+	float InputManager::GetEventAge( const InputEvent& event ) const
+	{
+		// Unsigned, so SDL_GetTicks wrapping around is fine; an event stamped after the poll is 0 seconds old
+		Uint32 age = mPollTicks - event.mTimestamp;
+		return ( age < 0x80000000u ) ? age / 1000.f : 0.f;
+	}
+
+	void InputManager::PushEvent( const InputEvent& event )
+	{
+		// The ring is full of this frame's events: the oldest one is lost
+		if ( mEventsPushed - mFrameEventsBegin == EVENT_CAPACITY )
+		{
+			++mFrameEventsBegin;
+			++mDroppedEvents;
+		}
+		mEvents[ mEventsPushed & ( EVENT_CAPACITY - 1 ) ] = event;
+		++mEventsPushed;
+
+		switch ( event.mType )
+		{
+		case InputEventType::KEY_DOWN:
+		case InputEventType::KEY_UP:
+			mKeyState[ event.mScancode ] = ( event.mType == InputEventType::KEY_DOWN ) ? 1 : 0;
+			break;
+		case InputEventType::MOUSE_BUTTON_DOWN:
+			mMouseButtonState |= GetButtonMask( event.mButton );
+			break;
+		case InputEventType::MOUSE_BUTTON_UP:
+			mMouseButtonState &= ~GetButtonMask( event.mButton );
+			break;
+		}
+	}
+
+	bool InputManager::HasFrameEvent( InputEventType type, SDL_Scancode scancode, MouseButton button ) const
+	{
+		bool isKeyEvent = ( type == InputEventType::KEY_DOWN || type == InputEventType::KEY_UP );
+		for ( std::size_t i = 0; i < GetFrameEventCount(); ++i )
+		{
+			const InputEvent& event = GetFrameEvent( i );
+			if ( event.mType == type && ( isKeyEvent ? event.mScancode == scancode : event.mButton == button ) )
+			{
+				return true;
+			}
+		}
+		return false;
 	}
 
 	bool InputManager::isKeyDown( SDL_Scancode scancode )
 	{
 		if (mKeyLock)
-			return false; 
-		return mCurrKeyState[ scancode ];
+			return false;
+		return mKeyState[ scancode ];
 	}
 
 	const bool InputManager::isKeyPressed( SDL_Scancode scancode ) const
 	{
 		if ( mKeyLock )
-			return false; 
+			return false;
 
-		return !mPrevKeyState[ scancode ] && mCurrKeyState[ scancode ];
+		return HasFrameEvent( InputEventType::KEY_DOWN, scancode, MouseButton::LEFT );
 	}
 
 	const bool InputManager::isKeyReleased( SDL_Scancode scancode ) const
 	{
-		return mPrevKeyState[ scancode ] && !mCurrKeyState[ scancode ];
+		return HasFrameEvent( InputEventType::KEY_UP, scancode, MouseButton::LEFT );
 	}
 
 	const bool InputManager::isMouseButtonDown( MouseButton button ) const
 	{
 		if ( mMouseLock )
-			return false; 
+			return false;
 
-		uint32_t mask = 0;
-		switch ( button )
-		{
-		case MouseButton::LEFT:
-			mask = SDL_BUTTON_LMASK;
-			break;
-		case MouseButton::RIGHT:
-			mask = SDL_BUTTON_RMASK;
-			break;
-		case MouseButton::MIDDLE:
-			mask = SDL_BUTTON_MMASK;
-			break;
-		case MouseButton::BACK:
-			mask = SDL_BUTTON_X1MASK;
-			break;
-		case MouseButton::FORWARD:
-			mask = SDL_BUTTON_X2MASK;
-			break;
-		}
-		return ( mCurrMouseState & mask );
+		return ( mMouseButtonState & GetButtonMask( button ) ) != 0;
 	}
 
 	const bool InputManager::isMouseButtonPressed( MouseButton button ) const
@@ -92,50 +201,25 @@ namespace venture
 		if ( mMouseLock )
 			return false;
 
-		uint32_t mask = 0;
-		switch ( button )
-		{
-		case MouseButton::LEFT:
-			mask = SDL_BUTTON_LMASK;
-			break;
-		case MouseButton::RIGHT:
-			mask = SDL_BUTTON_RMASK;
-			break;
-		case MouseButton::MIDDLE:
-			mask = SDL_BUTTON_MMASK;
-			break;
-		case MouseButton::BACK:
-			mask = SDL_BUTTON_X1MASK;
-			break;
-		case MouseButton::FORWARD:
-			mask = SDL_BUTTON_X2MASK;
-			break;
-		}
-		return !( mPrevMouseState & mask ) && ( mCurrMouseState & mask );
+		return HasFrameEvent( InputEventType::MOUSE_BUTTON_DOWN, SDL_SCANCODE_UNKNOWN, button );
 	}
 
 	const bool InputManager::isMouseButtonReleased( MouseButton button ) const
 	{
-		uint32_t mask = 0;
-		switch ( button )
-		{
-		case MouseButton::LEFT:
-			mask = SDL_BUTTON_LMASK;
-			break;
-		case MouseButton::RIGHT:
-			mask = SDL_BUTTON_RMASK;
-			break;
-		case MouseButton::MIDDLE:
-			mask = SDL_BUTTON_MMASK;
-			break;
-		case MouseButton::BACK:
-			mask = SDL_BUTTON_X1MASK;
-			break;
-		case MouseButton::FORWARD:
-			mask = SDL_BUTTON_X2MASK;
-			break;
-		}
-		return ( mPrevMouseState & mask ) && !( mCurrMouseState & mask );
+		return HasFrameEvent( InputEventType::MOUSE_BUTTON_UP, SDL_SCANCODE_UNKNOWN, button );
+	}
+
+	void InputManager::InjectKey( SDL_Scancode scancode, bool down, float age )
+	{
+		mInjectingKeys = true;
+
+		InputEvent event;
+		event.mType = down ? InputEventType::KEY_DOWN : InputEventType::KEY_UP;
+		event.mScancode = scancode;
+		// Relative to the last poll rather than the live clock, see ProcessInput
+		event.mTimestamp = mPollTicks - static_cast< Uint32 >( age * 1000.f );
+		event.mPollCounter = SDL_GetPerformanceCounter();
+		PushEvent( event );
 	}
 
 	glm::ivec2 InputManager::GetMousePosition()
@@ -145,4 +229,4 @@ namespace venture
 	}
 
 
-}
\ No newline at end of file
+}
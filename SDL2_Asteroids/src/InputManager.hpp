@@ -7,6 +7,10 @@
  * they are currently down, just pressed, or just released. The class uses the Singleton design
  * pattern to ensure only one instance manages input across the application.
  *
+ * Every key and mouse button press and release is kept, in order and timestamped, in a ring of events:
+ * a tap shorter than a frame still counts as pressed, and the frame's events can be walked to know
+ * when each one happened within the frame (see GetFrameEvent and GetEventAge).
+ *
  * Example usage:
  * @code
  * venture::InputManager* inputManager = venture::InputManager::get();
@@ -16,6 +20,12 @@
  * if (inputManager->isMouseButtonDown(venture::MouseButton::LEFT)) {
  *     // Handle left mouse button down event
  * }
+ * // Every press of the space-bar this frame, and how long ago it happened
+ * for (std::size_t i = 0; i < inputManager->GetFrameEventCount(); ++i) {
+ *     const venture::InputEvent& event = inputManager->GetFrameEvent(i);
+ *     if (event.mType == venture::InputEventType::KEY_DOWN && event.mScancode == SDL_SCANCODE_SPACE)
+ *         Fire(inputManager->GetEventAge(event));
+ * }
  * // Update input state at the end of the frame
  * inputManager->UpdatePrevInput();
  * @endcode
@@ -26,6 +36,8 @@
 
 #pragma once
 #include <SDL2/SDL.h>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <glm/glm.hpp>
 
@@ -41,6 +53,29 @@ namespace venture
 		FORWARD,
 	};
 
+	// Enumeration of the input event kinds
+	enum class InputEventType
+	{
+		KEY_DOWN,
+		KEY_UP,
+		MOUSE_BUTTON_DOWN,
+		MOUSE_BUTTON_UP,
+	};
+
+	// A key or mouse button press or release
+	struct InputEvent
+	{
+		InputEventType mType = InputEventType::KEY_DOWN;
+		// The key (key events)
+		SDL_Scancode mScancode = SDL_SCANCODE_UNKNOWN;
+		// The mouse button (mouse button events)
+		MouseButton mButton = MouseButton::LEFT;
+		// When the event happened, in SDL ticks (milliseconds, see SDL_GetTicks)
+		uint32_t mTimestamp = 0;
+		// When ProcessInput polled the event (SDL_GetPerformanceCounter)
+		uint64_t mPollCounter = 0;
+	};
+
 
 	class InputManager
 	{
@@ -61,15 +96,39 @@ namespace venture
 		///--------------------------------------------------------
 		
 		/**
-		 * @brief Processes input events.
+		 * @brief Polls the SDL events, queuing the key and mouse button ones.
 		 */
 		void ProcessInput( SDL_Event* event );
 		
 		/**
-		 * @brief Updates the state of inputs from the previous frame.
+		 * @brief Ends the input frame: the pressed and released checks and the frame's events start over.
 		 */
 		void UpdatePrevInput();
 
+		/// Events
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the number of events queued this frame (since the last UpdatePrevInput).
+		 */
+		std::size_t GetFrameEventCount() const;
+
+		/**
+		 * @brief Returns one of this frame's events, in the order they happened.
+		 * @param index The event's index, in [0, GetFrameEventCount()).
+		 */
+		const InputEvent& GetFrameEvent( std::size_t index ) const;
+
+		/**
+		 * @brief Returns how long before the last ProcessInput an event happened, in seconds.
+		 */
+		float GetEventAge( const InputEvent& event ) const;
+
+		/**
+		 * @brief Returns the number of events lost because a frame queued more than EVENT_CAPACITY.
+		 */
+		uint64_t GetDroppedEventCount() const { return mDroppedEvents; }
+
 		/// State Checks
 		///--------------------------------------------------------
 		
@@ -79,12 +138,12 @@ namespace venture
 		bool isKeyDown( SDL_Scancode scancode );
 		
 		/**
-		 * @brief Checks if a key is pressed
+		 * @brief Checks if a key was pressed this frame (even if it was released since)
 		 */
 		const bool isKeyPressed( SDL_Scancode scancode ) const;
 		
 		/**
-		 * @brief Checks if a key is released
+		 * @brief Checks if a key was released this frame
 		 */
 		const bool isKeyReleased( SDL_Scancode scancode ) const;
 		
@@ -155,6 +214,17 @@ namespace venture
 		 */
 		void UnlockKeyboard() { mKeyLock = false; }
 
+		/**
+		 * @brief Queues a key event, e.g. to replay recorded input.
+		 * From the first call on the keyboard state only changes through this (the real keyboard is ignored).
+		 * @param age How long before the next poll the event happened, in seconds (GetEventAge returns it as is,
+		 * so a replay's ages don't depend on how fast the machine runs).
+		 */
+		void InjectKey( SDL_Scancode scancode, bool down, float age = 0.f );
+
+		// Number of events the ring holds (a power of two)
+		static const std::size_t EVENT_CAPACITY = 256;
+
 	private:
 
 		// Private constructor and destructor to follow the singleton design pattern.
@@ -172,19 +242,36 @@ namespace venture
 		// The static instance of the class (to follow the singleton design pattern)
 		static InputManager* s_Instance;
 
-		// Previous keyboard state.
-		uint8_t* mPrevKeyState;
+		/**
+		 * @brief Queues an event and applies it to the keyboard or mouse state.
+		 */
+		void PushEvent( const InputEvent& event );
+
+		/**
+		 * @brief Checks if this frame queued an event.
+		 */
+		bool HasFrameEvent( InputEventType type, SDL_Scancode scancode, MouseButton button ) const;
 
-		// Current keyboard state.
-		const uint8_t* mCurrKeyState;
+		// The last EVENT_CAPACITY events
+		std::array<InputEvent, EVENT_CAPACITY> mEvents;
+		// Number of events ever queued (the ring's write position)
+		uint64_t mEventsPushed = 0;
+		// Value of mEventsPushed when the frame started
+		uint64_t mFrameEventsBegin = 0;
+		// Events overwritten before their frame ended
+		uint64_t mDroppedEvents = 0;
+		// SDL ticks when ProcessInput last polled the events
+		uint32_t mPollTicks = 0;
+		// Value of mEventsPushed after the last poll, the events queued after it were injected
+		uint64_t mPolledEvents = 0;
 
-		// Number of keys tracked.
-		int mKeyLength;
+		// Keyboard state (1 for the keys held down), kept by the key events.
+		std::array<uint8_t, SDL_NUM_SCANCODES> mKeyState{};
+		// Set by InjectKey, the real keyboard is ignored from then on.
+		bool mInjectingKeys = false;
 
-		// Previous mouse state.
-		uint32_t mPrevMouseState;
-		// Current mouse state.
-		uint32_t mCurrMouseState;
+		// Mouse buttons held down (SDL_BUTTON masks), kept by the mouse button events.
+		uint32_t mMouseButtonState = 0;
 
 		// Mouse positions.
 		int mMouseXPos, mMouseYPos; 
@@ -0,0 +1,68 @@
+#include "InputReplay.h"
+#include "InputManager.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+bool InputReplay::Load( const std::string& path )
+{
+	std::ifstream file( path );
+	if ( !file )
+	{
+		printf( "Failed to open the input replay %s!\n", path.c_str() );
+		return false;
+	}
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	return Parse( contents.str() );
+}
+
+bool InputReplay::Parse( const std::string& text )
+{
+	bool valid = true;
+	std::istringstream lines( text );
+	std::string line;
+	while ( std::getline( lines, line ) )
+	{
+		line = line.substr( 0, line.find( '#' ) );
+
+		std::istringstream fields( line );
+		double time = 0.0;
+		std::string key;
+		std::string state;
+		if ( !( fields >> time ) )
+		{
+			// Empty (or comment) lines have no time, anything else is an error
+			valid = valid && line.find_first_not_of( " \t\r" ) == std::string::npos;
+			continue;
+		}
+
+		SDL_Scancode scancode = ( fields >> key ) ? SDL_GetScancodeFromName( key.c_str() ) : SDL_SCANCODE_UNKNOWN;
+		if ( scancode == SDL_SCANCODE_UNKNOWN || !( fields >> state ) || ( state != "down" && state != "up" ) )
+		{
+			printf( "Invalid input replay line '%s'!\n", line.c_str() );
+			valid = false;
+			continue;
+		}
+
+		mEvents.push_back( { time, scancode, state == "down" } );
+	}
+
+	std::stable_sort( mEvents.begin(), mEvents.end(), []( const Event& a, const Event& b ) { return a.mTime < b.mTime; } );
+	mNextEvent = 0;
+	return valid;
+}
+
+void InputReplay::Apply( double time )
+{
+	auto input = venture::InputManager::get();
+	while ( mNextEvent < mEvents.size() && mEvents[ mNextEvent ].mTime <= time )
+	{
+		// Stamped with when the event happened between the last apply and this one
+		input->InjectKey( mEvents[ mNextEvent ].mScancode, mEvents[ mNextEvent ].mDown, static_cast< float >( time - mEvents[ mNextEvent ].mTime ) );
+		++mNextEvent;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+// Replays recorded key presses into the InputManager against the simulated time, so a run
+// (e.g. a benchmark run on a fixed time step) sees the same input on every run.
+//
+// A replay has an event per line: the time in seconds, the key's SDL name and "down" or "up".
+// '#' starts a comment.
+//
+// @code
+// 0.5 Up down      # Thrust for a second
+// 1.5 Up up
+// 2.0 Space down   # Fire
+// 2.1 Space up
+// @endcode
+
+class InputReplay
+{
+public:
+
+	/// Loading
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Loads a replay file.
+	 * @return false if the file couldn't be read or has an invalid line.
+	 */
+	bool Load( const std::string& path );
+
+	/**
+	 * @brief Parses a replay's text.
+	 * @return false if a line is invalid (the valid lines are still kept).
+	 */
+	bool Parse( const std::string& text );
+
+	/// Playback
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Injects every event up to a time that hasn't been injected yet.
+	 * @param time The simulated time, in seconds.
+	 */
+	void Apply( double time );
+
+	/**
+	 * @brief Rewinds the replay to its start.
+	 */
+	void Rewind() { mNextEvent = 0; }
+
+	/**
+	 * @brief Checks if every event was injected.
+	 */
+	bool IsFinished() const { return mNextEvent >= mEvents.size(); }
+
+	/**
+	 * @brief Returns the number of events in the replay.
+	 */
+	std::size_t GetEventCount() const { return mEvents.size(); }
+
+private:
+	// A recorded key change
+	struct Event
+	{
+		double mTime;
+		SDL_Scancode mScancode;
+		bool mDown;
+	};
+
+	// The events, sorted by time
+	std::vector<Event> mEvents;
+	// The next event to inject
+	std::size_t mNextEvent = 0;
+};
@@ -0,0 +1,235 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+namespace venture
+{
+	namespace
+	{
+		// The JobSystem the calling thread works for (null for threads that aren't workers)
+		thread_local const JobSystem* tJobSystem = nullptr;
+		// The calling worker's deque index
+		thread_local unsigned tQueueIndex = 0;
+	}
+
+	JobSystem::JobSystem( unsigned workerCount )
+		: mQueuedJobs( 0 ), mStopping( false )
+	{
+		if ( workerCount == 0 )
+		{
+			unsigned hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		for ( unsigned i = 0; i < workerCount + 1; ++i )
+		{
+			mQueues.push_back( std::make_unique<WorkQueue>() );
+		}
+
+		for ( unsigned i = 0; i < workerCount; ++i )
+		{
+			mWorkers.emplace_back( &JobSystem::WorkerLoop, this, i + 1 );
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		mStopping = true;
+		{
+			std::lock_guard<std::mutex> lock( mSleepMutex );
+		}
+		mSleepCondition.notify_all();
+
+		for ( auto& worker : mWorkers )
+		{
+			worker.join();
+		}
+	}
+
+	JobHandle JobSystem::Schedule( JobFunction function, std::initializer_list<JobHandle> dependencies )
+	{
+		return ScheduleAfter( std::move( function ), dependencies.begin(), dependencies.size() );
+	}
+
+	JobHandle JobSystem::ScheduleAfter( JobFunction function, const JobHandle* dependencies, std::size_t dependencyCount )
+	{
+		auto job = std::make_shared<Job>();
+		job->mFunction = std::move( function );
+
+		// The extra count keeps the job from being queued while its dependencies are registered
+		job->mPendingDependencies = static_cast< int >( dependencyCount ) + 1;
+
+		for ( std::size_t i = 0; i < dependencyCount; ++i )
+		{
+			const JobHandle& dependency = dependencies[ i ];
+			if ( dependency )
+			{
+				std::lock_guard<std::mutex> lock( dependency->mMutex );
+				if ( !dependency->mDone )
+				{
+					dependency->mContinuations.push_back( job );
+					continue;
+				}
+			}
+			--job->mPendingDependencies;
+		}
+
+		if ( --job->mPendingDependencies == 0 )
+		{
+			Enqueue( job );
+		}
+
+		return job;
+	}
+
+	JobHandle JobSystem::ScheduleParallelFor( std::size_t count, std::size_t grainSize, RangeFunction function,
+											  std::initializer_list<JobHandle> dependencies )
+	{
+		grainSize = std::max<std::size_t>( grainSize, 1 );
+
+		// The chunks share the range function
+		auto shared = std::make_shared<RangeFunction>( std::move( function ) );
+
+		// A gate job lets every chunk depend on the caller's dependencies through a single handle
+		JobHandle gate = ScheduleAfter( []() {}, dependencies.begin(), dependencies.size() );
+
+		std::vector<JobHandle> chunks;
+		chunks.reserve( ( count + grainSize - 1 ) / grainSize );
+		for ( std::size_t begin = 0; begin < count; begin += grainSize )
+		{
+			std::size_t end = std::min( count, begin + grainSize );
+			chunks.push_back( ScheduleAfter( [ shared, begin, end ]() { ( *shared )( begin, end ); }, &gate, 1 ) );
+		}
+
+		if ( chunks.empty() )
+		{
+			return gate;
+		}
+
+		return ScheduleAfter( []() {}, chunks.data(), chunks.size() );
+	}
+
+	void JobSystem::ParallelFor( std::size_t count, std::size_t grainSize, const RangeFunction& function )
+	{
+		if ( count <= grainSize || mWorkers.empty() )
+		{
+			function( 0, count );
+			return;
+		}
+
+		Wait( ScheduleParallelFor( count, grainSize, function ) );
+	}
+
+	void JobSystem::Wait( const JobHandle& job )
+	{
+		if ( !job )
+		{
+			return;
+		}
+
+		unsigned queueIndex = GetQueueIndex();
+		while ( !job->mDone )
+		{
+			if ( JobHandle next = FindJob( queueIndex ) )
+			{
+				Execute( next );
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::WorkerLoop( unsigned queueIndex )
+	{
+		tJobSystem = this;
+		tQueueIndex = queueIndex;
+
+		while ( !mStopping )
+		{
+			if ( JobHandle job = FindJob( queueIndex ) )
+			{
+				Execute( job );
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock( mSleepMutex );
+			mSleepCondition.wait( lock, [ this ]() { return mStopping || mQueuedJobs > 0; } );
+		}
+	}
+
+	void JobSystem::Enqueue( JobHandle job )
+	{
+		WorkQueue& queue = *mQueues[ GetQueueIndex() ];
+		{
+			std::lock_guard<std::mutex> lock( queue.mMutex );
+			queue.mJobs.push_back( std::move( job ) );
+		}
+		++mQueuedJobs;
+
+		// Taking the lock orders the increment with a worker checking the count before sleeping
+		{
+			std::lock_guard<std::mutex> lock( mSleepMutex );
+		}
+		mSleepCondition.notify_one();
+	}
+
+	JobHandle JobSystem::FindJob( unsigned queueIndex )
+	{
+		// Own deque first, newest job (its data is most likely still in cache)
+		{
+			WorkQueue& own = *mQueues[ queueIndex ];
+			std::lock_guard<std::mutex> lock( own.mMutex );
+			if ( !own.mJobs.empty() )
+			{
+				JobHandle job = std::move( own.mJobs.back() );
+				own.mJobs.pop_back();
+				--mQueuedJobs;
+				return job;
+			}
+		}
+
+		// Steal the oldest job from another deque
+		std::size_t queueCount = mQueues.size();
+		for ( std::size_t i = 1; i < queueCount; ++i )
+		{
+			WorkQueue& victim = *mQueues[ ( queueIndex + i ) % queueCount ];
+			std::lock_guard<std::mutex> lock( victim.mMutex );
+			if ( !victim.mJobs.empty() )
+			{
+				JobHandle job = std::move( victim.mJobs.front() );
+				victim.mJobs.pop_front();
+				--mQueuedJobs;
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void JobSystem::Execute( const JobHandle& job )
+	{
+		job->mFunction();
+
+		std::vector<JobHandle> continuations;
+		{
+			std::lock_guard<std::mutex> lock( job->mMutex );
+			job->mDone = true;
+			continuations.swap( job->mContinuations );
+		}
+
+		for ( auto& continuation : continuations )
+		{
+			if ( --continuation->mPendingDependencies == 0 )
+			{
+				Enqueue( std::move( continuation ) );
+			}
+		}
+	}
+
+	unsigned JobSystem::GetQueueIndex() const
+	{
+		return tJobSystem == this ? tQueueIndex : 0;
+	}
+}
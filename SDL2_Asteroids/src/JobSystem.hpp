@@ -0,0 +1,180 @@
+/**
+ * @class JobSystem
+ * @brief A lightweight work-stealing task scheduler.
+ *
+ * Every worker thread (and the thread that created the JobSystem) owns a job deque.
+ * A thread pushes and pops jobs at the back of its own deque, and when it runs out of work
+ * it steals from the front of the other deques. Jobs can depend on other jobs, a job is only
+ * queued once all of its dependencies have finished, which lets independent phases of a frame
+ * overlap while dependent ones keep their order.
+ *
+ * Example usage:
+ * @code
+ * venture::JobSystem jobs;
+ * auto build = jobs.Schedule( [&]() { BuildGrid(); } );
+ * auto move = jobs.ScheduleParallelFor( count, 256, [&]( std::size_t begin, std::size_t end ) {
+ *     MoveObjects( begin, end );
+ * }, { build } );
+ * jobs.Wait( move ); // The waiting thread helps running jobs until 'move' is done
+ * @endcode
+ *
+ * @note Wait() must only be called from the thread that created the JobSystem or from inside a job.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace venture
+{
+	// A unit of work scheduled on the JobSystem
+	struct Job;
+
+	// Handle to a scheduled job, used to wait for it or as another job's dependency
+	using JobHandle = std::shared_ptr<Job>;
+
+	// The work a job runs
+	using JobFunction = std::function<void()>;
+
+	// The work a parallel-for chunk runs, over the index range [begin, end)
+	using RangeFunction = std::function<void( std::size_t begin, std::size_t end )>;
+
+	struct Job
+	{
+		// The job's work
+		JobFunction mFunction;
+		// Number of unfinished dependencies (+1 while the job is being scheduled)
+		std::atomic<int> mPendingDependencies{ 0 };
+		// Set once the job has run
+		std::atomic<bool> mDone{ false };
+		// Guards mContinuations
+		std::mutex mMutex;
+		// Jobs waiting for this job to finish
+		std::vector<JobHandle> mContinuations;
+	};
+
+	class JobSystem
+	{
+	public:
+
+		/// Constructors & Destructors
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Constructor for the JobSystem class, starts the worker threads.
+		 * @param workerCount Number of worker threads, 0 uses one per hardware thread (minus the calling thread).
+		 */
+		explicit JobSystem( unsigned workerCount = 0 );
+
+		/**
+		 * @brief Destructor for the JobSystem class, joins the worker threads.
+		 */
+		~JobSystem();
+
+		/// Scheduling
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Schedules a job that runs once all of its dependencies are done.
+		 * @param function The job's work.
+		 * @param dependencies Jobs that must finish before this one starts.
+		 * @return A handle to the scheduled job.
+		 */
+		JobHandle Schedule( JobFunction function, std::initializer_list<JobHandle> dependencies = {} );
+
+		/**
+		 * @brief Splits [0, count) into chunks of at most grainSize indices, and schedules a job per chunk.
+		 * @param count Number of indices.
+		 * @param grainSize Maximum chunk size.
+		 * @param function The work for a chunk.
+		 * @param dependencies Jobs that must finish before any chunk starts.
+		 * @return A handle that is done once every chunk is done.
+		 */
+		JobHandle ScheduleParallelFor( std::size_t count, std::size_t grainSize, RangeFunction function,
+									   std::initializer_list<JobHandle> dependencies = {} );
+
+		/**
+		 * @brief Runs a parallel-for and waits for it, small counts run inline on the calling thread.
+		 */
+		void ParallelFor( std::size_t count, std::size_t grainSize, const RangeFunction& function );
+
+		/**
+		 * @brief Waits for a job to finish, running other jobs in the meantime.
+		 * @param job The job to wait for (a null handle returns immediately).
+		 */
+		void Wait( const JobHandle& job );
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the number of worker threads (not counting the thread that created the JobSystem).
+		 */
+		unsigned GetWorkerCount() const { return static_cast< unsigned >( mWorkers.size() ); }
+
+	private:
+		// A job deque owned by a single thread
+		struct WorkQueue
+		{
+			std::mutex mMutex;
+			std::deque<JobHandle> mJobs;
+		};
+
+		/**
+		 * @brief Schedules a job with a list of dependencies.
+		 */
+		JobHandle ScheduleAfter( JobFunction function, const JobHandle* dependencies, std::size_t dependencyCount );
+
+		/**
+		 * @brief The worker threads main loop.
+		 */
+		void WorkerLoop( unsigned queueIndex );
+
+		/**
+		 * @brief Pushes a ready job on the calling thread's deque and wakes a sleeping worker.
+		 */
+		void Enqueue( JobHandle job );
+
+		/**
+		 * @brief Pops a job from the thread's own deque, or steals one from another deque.
+		 */
+		JobHandle FindJob( unsigned queueIndex );
+
+		/**
+		 * @brief Runs a job and releases the jobs that depend on it.
+		 */
+		void Execute( const JobHandle& job );
+
+		/**
+		 * @brief Returns the deque index of the calling thread.
+		 */
+		unsigned GetQueueIndex() const;
+
+	private:
+		// One deque per worker, index 0 belongs to the thread that created the JobSystem
+		std::vector<std::unique_ptr<WorkQueue>> mQueues;
+		// The worker threads
+		std::vector<std::thread> mWorkers;
+
+		// Number of jobs sitting in the deques
+		std::atomic<int> mQueuedJobs;
+		// Set when the workers should exit
+		std::atomic<bool> mStopping;
+
+		// Sleeping workers wait on this until jobs are queued
+		std::mutex mSleepMutex;
+		std::condition_variable mSleepCondition;
+
+		// Deleted constructors and assignment operators
+		JobSystem( const JobSystem& ) = delete;
+		JobSystem& operator=( const JobSystem& ) = delete;
+	};
+}
@@ -0,0 +1,253 @@
+#include "Kinematics.h"
+#include "Game.h"
+#include "Simd.h"
+
+void KinematicsBatch::Clear()
+{
+	mPositionsX.clear();
+	mPositionsY.clear();
+	mVelocitiesX.clear();
+	mVelocitiesY.clear();
+	mSizes.clear();
+}
+
+void KinematicsBatch::Reserve( std::size_t count )
+{
+	mPositionsX.reserve( count );
+	mPositionsY.reserve( count );
+	mVelocitiesX.reserve( count );
+	mVelocitiesY.reserve( count );
+	mSizes.reserve( count );
+}
+
+void KinematicsBatch::Push( const SpaceObject& obj )
+{
+	mPositionsX.push_back( obj.mPosition.x );
+	mPositionsY.push_back( obj.mPosition.y );
+	mVelocitiesX.push_back( obj.mVelocity.x );
+	mVelocitiesY.push_back( obj.mVelocity.y );
+	mSizes.push_back( static_cast< float >( obj.mSize ) );
+}
+
+void KinematicsBatch::SwapRemove( std::size_t index )
+{
+	std::size_t last = Size() - 1;
+	mPositionsX[ index ] = mPositionsX[ last ];
+	mPositionsY[ index ] = mPositionsY[ last ];
+	mVelocitiesX[ index ] = mVelocitiesX[ last ];
+	mVelocitiesY[ index ] = mVelocitiesY[ last ];
+	mSizes[ index ] = mSizes[ last ];
+
+	mPositionsX.pop_back();
+	mPositionsY.pop_back();
+	mVelocitiesX.pop_back();
+	mVelocitiesY.pop_back();
+	mSizes.pop_back();
+}
+
+namespace
+{
+	// Wraps a single coordinate, the ternaries compile to selects (no branches)
+	inline float WrapScalar( float p, float size, float extent )
+	{
+		float high = extent + size;
+		p = ( p > high ) ? -size : p;
+		p = ( p < -size ) ? high : p;
+		return p;
+	}
+
+	void IntegrateScalar( KinematicsBatch& batch, std::size_t begin, std::size_t end, float dt, bool wrap )
+	{
+		float* px = batch.mPositionsX.data();
+		float* py = batch.mPositionsY.data();
+		const float* vx = batch.mVelocitiesX.data();
+		const float* vy = batch.mVelocitiesY.data();
+		const float* s = batch.mSizes.data();
+
+		const float width = static_cast< float >( SCREEN_WIDTH );
+		const float height = static_cast< float >( SCREEN_HEIGHT );
+
+		for ( std::size_t i = begin; i < end; ++i )
+		{
+			float x = px[ i ] + vx[ i ] * dt;
+			float y = py[ i ] + vy[ i ] * dt;
+			if ( wrap )
+			{
+				x = WrapScalar( x, s[ i ], width );
+				y = WrapScalar( y, s[ i ], height );
+			}
+			px[ i ] = x;
+			py[ i ] = y;
+		}
+	}
+
+#ifdef ASTEROIDS_HAS_SSE2
+	// Selects b where mask is set, otherwise a
+	inline __m128 Select( __m128 a, __m128 b, __m128 mask )
+	{
+		return _mm_or_ps( _mm_andnot_ps( mask, a ), _mm_and_ps( mask, b ) );
+	}
+
+	inline __m128 WrapSSE2( __m128 p, __m128 size, __m128 extent )
+	{
+		__m128 low = _mm_sub_ps( _mm_setzero_ps(), size );
+		__m128 high = _mm_add_ps( extent, size );
+		p = Select( p, low, _mm_cmpgt_ps( p, high ) );
+		p = Select( p, high, _mm_cmplt_ps( p, low ) );
+		return p;
+	}
+
+	void IntegrateSSE2( KinematicsBatch& batch, std::size_t begin, std::size_t end, float dt, bool wrap )
+	{
+		float* px = batch.mPositionsX.data();
+		float* py = batch.mPositionsY.data();
+		const float* vx = batch.mVelocitiesX.data();
+		const float* vy = batch.mVelocitiesY.data();
+		const float* s = batch.mSizes.data();
+
+		const __m128 vdt = _mm_set1_ps( dt );
+		const __m128 width = _mm_set1_ps( static_cast< float >( SCREEN_WIDTH ) );
+		const __m128 height = _mm_set1_ps( static_cast< float >( SCREEN_HEIGHT ) );
+
+		std::size_t i = begin;
+		for ( ; i + 4 <= end; i += 4 )
+		{
+			__m128 x = _mm_add_ps( _mm_loadu_ps( px + i ), _mm_mul_ps( _mm_loadu_ps( vx + i ), vdt ) );
+			__m128 y = _mm_add_ps( _mm_loadu_ps( py + i ), _mm_mul_ps( _mm_loadu_ps( vy + i ), vdt ) );
+			if ( wrap )
+			{
+				__m128 size = _mm_loadu_ps( s + i );
+				x = WrapSSE2( x, size, width );
+				y = WrapSSE2( y, size, height );
+			}
+			_mm_storeu_ps( px + i, x );
+			_mm_storeu_ps( py + i, y );
+		}
+
+		// Remainder
+		IntegrateScalar( batch, i, end, dt, wrap );
+	}
+#endif
+
+#ifdef ASTEROIDS_HAS_AVX2
+	inline __m256 WrapAVX2( __m256 p, __m256 size, __m256 extent )
+	{
+		__m256 low = _mm256_sub_ps( _mm256_setzero_ps(), size );
+		__m256 high = _mm256_add_ps( extent, size );
+		p = _mm256_blendv_ps( p, low, _mm256_cmp_ps( p, high, _CMP_GT_OQ ) );
+		p = _mm256_blendv_ps( p, high, _mm256_cmp_ps( p, low, _CMP_LT_OQ ) );
+		return p;
+	}
+
+	void IntegrateAVX2( KinematicsBatch& batch, std::size_t begin, std::size_t end, float dt, bool wrap )
+	{
+		float* px = batch.mPositionsX.data();
+		float* py = batch.mPositionsY.data();
+		const float* vx = batch.mVelocitiesX.data();
+		const float* vy = batch.mVelocitiesY.data();
+		const float* s = batch.mSizes.data();
+
+		const __m256 vdt = _mm256_set1_ps( dt );
+		const __m256 width = _mm256_set1_ps( static_cast< float >( SCREEN_WIDTH ) );
+		const __m256 height = _mm256_set1_ps( static_cast< float >( SCREEN_HEIGHT ) );
+
+		std::size_t i = begin;
+		for ( ; i + 8 <= end; i += 8 )
+		{
+			__m256 x = _mm256_fmadd_ps( _mm256_loadu_ps( vx + i ), vdt, _mm256_loadu_ps( px + i ) );
+			__m256 y = _mm256_fmadd_ps( _mm256_loadu_ps( vy + i ), vdt, _mm256_loadu_ps( py + i ) );
+			if ( wrap )
+			{
+				__m256 size = _mm256_loadu_ps( s + i );
+				x = WrapAVX2( x, size, width );
+				y = WrapAVX2( y, size, height );
+			}
+			_mm256_storeu_ps( px + i, x );
+			_mm256_storeu_ps( py + i, y );
+		}
+
+		// Remainder
+		IntegrateScalar( batch, i, end, dt, wrap );
+	}
+#endif
+}
+
+namespace Kinematics
+{
+	KinematicsBackend GetBestBackend()
+	{
+#if defined( ASTEROIDS_HAS_AVX2 )
+		return KinematicsBackend::AVX2;
+#elif defined( ASTEROIDS_HAS_SSE2 )
+		return KinematicsBackend::SSE2;
+#else
+		return KinematicsBackend::Scalar;
+#endif
+	}
+
+	const char* GetBackendName( KinematicsBackend backend )
+	{
+		switch ( backend )
+		{
+		case KinematicsBackend::SSE2:
+			return "SSE2";
+		case KinematicsBackend::AVX2:
+			return "AVX2";
+		default:
+			return "Scalar";
+		}
+	}
+
+	bool IsBackendAvailable( KinematicsBackend backend )
+	{
+		switch ( backend )
+		{
+#ifdef ASTEROIDS_HAS_SSE2
+		case KinematicsBackend::SSE2:
+			return true;
+#endif
+#ifdef ASTEROIDS_HAS_AVX2
+		case KinematicsBackend::AVX2:
+			return true;
+#endif
+		case KinematicsBackend::Scalar:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void IntegrateRange( KinematicsBatch& batch, std::size_t begin, std::size_t end, float deltaTime, bool wrap,
+						 KinematicsBackend backend )
+	{
+		switch ( backend )
+		{
+#ifdef ASTEROIDS_HAS_AVX2
+		case KinematicsBackend::AVX2:
+			IntegrateAVX2( batch, begin, end, deltaTime, wrap );
+			return;
+#endif
+#ifdef ASTEROIDS_HAS_SSE2
+		case KinematicsBackend::SSE2:
+			IntegrateSSE2( batch, begin, end, deltaTime, wrap );
+			return;
+#endif
+		default:
+			IntegrateScalar( batch, begin, end, deltaTime, wrap );
+			return;
+		}
+	}
+
+	void Integrate( SpaceObject& obj, float deltaTime )
+	{
+		obj.mPosition.x += obj.mVelocity.x * deltaTime;
+		obj.mPosition.y += obj.mVelocity.y * deltaTime;
+	}
+
+	void Wrap( SpaceObject& obj )
+	{
+		auto fSize = static_cast< float >( obj.mSize );
+		obj.mPosition.x = WrapScalar( obj.mPosition.x, fSize, static_cast< float >( SCREEN_WIDTH ) );
+		obj.mPosition.y = WrapScalar( obj.mPosition.y, fSize, static_cast< float >( SCREEN_HEIGHT ) );
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "SpaceObject.h"
+
+// Packed (structure of arrays) kinematic state shared by every moving object in the game.
+// Asteroids and bullets are integrated through the same kernel, which walks the arrays
+// several objects at a time (SSE2 / AVX2) and wraps positions without branching.
+
+/**
+ * @brief The instruction set used by the integration kernel.
+ */
+enum class KinematicsBackend
+{
+	Scalar,
+	SSE2,
+	AVX2,
+};
+
+/**
+ * @brief Structure of arrays holding the position, velocity and size of a group of objects.
+ */
+struct KinematicsBatch
+{
+	// Objects x positions
+	std::vector<float> mPositionsX;
+	// Objects y positions
+	std::vector<float> mPositionsY;
+	// Objects x velocities
+	std::vector<float> mVelocitiesX;
+	// Objects y velocities
+	std::vector<float> mVelocitiesY;
+	// Objects sizes (used as the wrapping margin)
+	std::vector<float> mSizes;
+
+	/**
+	 * @brief Returns the number of objects in the batch.
+	 */
+	std::size_t Size() const { return mPositionsX.size(); }
+
+	/**
+	 * @brief Removes every object from the batch, keeping the allocated capacity.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Reserves room for count objects.
+	 */
+	void Reserve( std::size_t count );
+
+	/**
+	 * @brief Appends a space object to the end of the batch.
+	 * @param obj The space object to append.
+	 */
+	void Push( const SpaceObject& obj );
+
+	/**
+	 * @brief Removes the object at index by moving the last object into its slot (order is not kept).
+	 * @param index The index of the object to remove.
+	 */
+	void SwapRemove( std::size_t index );
+};
+
+namespace Kinematics
+{
+	/**
+	 * @brief Returns the fastest backend compiled into this build.
+	 */
+	KinematicsBackend GetBestBackend();
+
+	/**
+	 * @brief Returns a printable name of a backend.
+	 */
+	const char* GetBackendName( KinematicsBackend backend );
+
+	/**
+	 * @brief Checks if a backend was compiled into this build.
+	 */
+	bool IsBackendAvailable( KinematicsBackend backend );
+
+	/**
+	 * @brief Integrates position += velocity * deltaTime for the objects in [begin, end),
+	 * and optionally wraps them around the screen (branchless).
+	 * @param batch The objects to integrate.
+	 * @param begin The first object index.
+	 * @param end One past the last object index.
+	 * @param deltaTime Time elapsed since the last update.
+	 * @param wrap Whether the objects should wrap around the screen edges.
+	 * @param backend The instruction set to run the kernel with.
+	 */
+	void IntegrateRange( KinematicsBatch& batch, std::size_t begin, std::size_t end, float deltaTime, bool wrap,
+						 KinematicsBackend backend = GetBestBackend() );
+
+	/**
+	 * @brief Integrates (and optionally wraps) the whole batch.
+	 */
+	inline void Integrate( KinematicsBatch& batch, float deltaTime, bool wrap )
+	{
+		IntegrateRange( batch, 0, batch.Size(), deltaTime, wrap );
+	}
+
+	/**
+	 * @brief Integrates a single space object, without wrapping.
+	 */
+	void Integrate( SpaceObject& obj, float deltaTime );
+
+	/**
+	 * @brief Wraps a single space object around the screen edges (branchless).
+	 */
+	void Wrap( SpaceObject& obj );
+}
@@ -0,0 +1,168 @@
+#include "LineBatcher.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace venture
+{
+	void LineBatcher::AddPolygon( const std::pair<float, float>* points, std::size_t count, const SDL_Color& color )
+	{
+		if ( count < 2 )
+		{
+			return;
+		}
+
+		SDL_FPoint* out = GetPolygonPoints( AllocatePolygon( count, color ) );
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			out[ i ] = { points[ i ].first, points[ i ].second };
+		}
+	}
+
+	LinePolygonSlot LineBatcher::AllocatePolygon( std::size_t count, const SDL_Color& color )
+	{
+		ColorBatch& batch = GetColorBatch( color );
+		LinePolygonSlot slot = { static_cast< std::size_t >( &batch - mBatches.data() ), batch.mPoints.size() };
+
+		// One extra vertex closes the polygon
+		batch.mPoints.resize( batch.mPoints.size() + count + 1 );
+		batch.mPolygonEnds.push_back( static_cast< int >( batch.mPoints.size() ) );
+		return slot;
+	}
+
+	int LineBatcher::Flush( SDL_Renderer* renderer )
+	{
+		mDrawCalls = 0;
+		mLines = 0;
+		for ( std::size_t b = 0; b < mUsedBatches; ++b )
+		{
+			ColorBatch& batch = mBatches[ b ];
+			mLines += static_cast< int >( batch.mPoints.size() - batch.mPolygonEnds.size() );
+
+			// Close the polygons
+			int start = 0;
+			for ( int end : batch.mPolygonEnds )
+			{
+				batch.mPoints[ end - 1 ] = batch.mPoints[ start ];
+				start = end;
+			}
+		}
+
+		if ( mLines > 0 )
+		{
+			if ( mMode == LineBatchMode::Geometry && !FlushGeometry( renderer ) )
+			{
+				printf( "SDL_RenderGeometry failed, falling back to line strips! Error: %s\n", SDL_GetError() );
+				mMode = LineBatchMode::Lines;
+			}
+
+			if ( mMode == LineBatchMode::Lines )
+			{
+				FlushLines( renderer );
+			}
+		}
+
+		for ( std::size_t b = 0; b < mUsedBatches; ++b )
+		{
+			mBatches[ b ].mPoints.clear();
+			mBatches[ b ].mPolygonEnds.clear();
+		}
+		mUsedBatches = 0;
+
+		return mDrawCalls;
+	}
+
+	LineBatcher::ColorBatch& LineBatcher::GetColorBatch( const SDL_Color& color )
+	{
+		for ( std::size_t b = 0; b < mUsedBatches; ++b )
+		{
+			const SDL_Color& c = mBatches[ b ].mColor;
+			if ( c.r == color.r && c.g == color.g && c.b == color.b && c.a == color.a )
+			{
+				return mBatches[ b ];
+			}
+		}
+
+		if ( mUsedBatches == mBatches.size() )
+		{
+			mBatches.emplace_back();
+		}
+
+		ColorBatch& batch = mBatches[ mUsedBatches++ ];
+		batch.mColor = color;
+		return batch;
+	}
+
+	bool LineBatcher::FlushGeometry( SDL_Renderer* renderer )
+	{
+		mVertices.clear();
+		mIndices.clear();
+		mVertices.reserve( mLines * 4 );
+		mIndices.reserve( mLines * 6 );
+
+		// Half of the line width
+		const float halfWidth = 0.5f;
+
+		for ( std::size_t b = 0; b < mUsedBatches; ++b )
+		{
+			const ColorBatch& batch = mBatches[ b ];
+			int start = 0;
+			for ( int end : batch.mPolygonEnds )
+			{
+				for ( int i = start; i < end - 1; ++i )
+				{
+					const SDL_FPoint& a = batch.mPoints[ i ];
+					const SDL_FPoint& c = batch.mPoints[ i + 1 ];
+
+					// Offset both ends along the edge's normal
+					float dx = c.x - a.x;
+					float dy = c.y - a.y;
+					float length = std::sqrt( dx * dx + dy * dy );
+					float scale = length > 0.f ? halfWidth / length : 0.f;
+					float nx = -dy * scale;
+					float ny = dx * scale;
+
+					int first = static_cast< int >( mVertices.size() );
+					mVertices.push_back( { { a.x + nx, a.y + ny }, batch.mColor, { 0.f, 0.f } } );
+					mVertices.push_back( { { a.x - nx, a.y - ny }, batch.mColor, { 0.f, 0.f } } );
+					mVertices.push_back( { { c.x + nx, c.y + ny }, batch.mColor, { 0.f, 0.f } } );
+					mVertices.push_back( { { c.x - nx, c.y - ny }, batch.mColor, { 0.f, 0.f } } );
+
+					mIndices.push_back( first );
+					mIndices.push_back( first + 1 );
+					mIndices.push_back( first + 2 );
+					mIndices.push_back( first + 1 );
+					mIndices.push_back( first + 3 );
+					mIndices.push_back( first + 2 );
+				}
+				start = end;
+			}
+		}
+
+		// A failed call isn't counted, the caller falls back to FlushLines (which counts its own calls)
+		if ( SDL_RenderGeometry( renderer, nullptr, mVertices.data(), static_cast< int >( mVertices.size() ),
+								 mIndices.data(), static_cast< int >( mIndices.size() ) ) != 0 )
+		{
+			return false;
+		}
+		++mDrawCalls;
+		return true;
+	}
+
+	void LineBatcher::FlushLines( SDL_Renderer* renderer )
+	{
+		for ( std::size_t b = 0; b < mUsedBatches; ++b )
+		{
+			const ColorBatch& batch = mBatches[ b ];
+			SDL_SetRenderDrawColor( renderer, batch.mColor.r, batch.mColor.g, batch.mColor.b, batch.mColor.a );
+
+			int start = 0;
+			for ( int end : batch.mPolygonEnds )
+			{
+				SDL_RenderDrawLinesF( renderer, &batch.mPoints[ start ], end - start );
+				++mDrawCalls;
+				start = end;
+			}
+		}
+	}
+}
@@ -0,0 +1,152 @@
+/**
+ * @class LineBatcher
+ * @brief Accumulates a frame's wire frame polygons and submits them to SDL in as few draw calls as possible.
+ *
+ * Polygons are grouped by color while they are added, nothing is drawn until Flush() is called.
+ * Two submission modes are supported:
+ * - Geometry: every edge becomes a thin quad, all the edges (of every color) go out in a single
+ *   SDL_RenderGeometry call.
+ * - Lines: one SDL_SetRenderDrawColor per color, and one SDL_RenderDrawLinesF per polygon.
+ *
+ * Example usage:
+ * @code
+ * venture::LineBatcher batcher;
+ * batcher.AddPolygon( points, count, SDL_Color( 255, 255, 0, 255 ) );
+ * batcher.Flush( renderer ); // Draws everything added since the last flush
+ * @endcode
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+namespace venture
+{
+	// How the batched lines are submitted to SDL
+	enum class LineBatchMode
+	{
+		Geometry,
+		Lines,
+	};
+
+	// A polygon allocated in the line batch, see LineBatcher::AllocatePolygon
+	struct LinePolygonSlot
+	{
+		// The polygon's color batch
+		std::size_t mBatch;
+		// The polygon's first vertex in the color batch
+		std::size_t mOffset;
+	};
+
+	class LineBatcher
+	{
+	public:
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Adds a closed polygon to the batch.
+		 * @param points The polygon's vertices (already transformed to screen space).
+		 * @param count The number of vertices.
+		 * @param color The polygon's color.
+		 */
+		void AddPolygon( const std::pair<float, float>* points, std::size_t count, const SDL_Color& color );
+
+		/**
+		 * @brief Allocates a closed polygon in the batch, for the caller to write its vertices into.
+		 * Vertices can be written from any thread, once every polygon of the frame has been allocated
+		 * (allocating may move the vertices written so far).
+		 * @param count The number of vertices (at least 2).
+		 * @param color The polygon's color.
+		 * @return The polygon's slot, see GetPolygonPoints.
+		 */
+		LinePolygonSlot AllocatePolygon( std::size_t count, const SDL_Color& color );
+
+		/**
+		 * @brief Returns where an allocated polygon's vertices go (room for the count given to AllocatePolygon).
+		 */
+		SDL_FPoint* GetPolygonPoints( const LinePolygonSlot& slot ) { return &mBatches[ slot.mBatch ].mPoints[ slot.mOffset ]; }
+
+		/**
+		 * @brief Draws every polygon added since the last flush, and empties the batch.
+		 * @param renderer The renderer that handles the draw calls
+		 * @return The number of SDL draw calls issued.
+		 */
+		int Flush( SDL_Renderer* renderer );
+
+		/// Setters & Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Sets the submission mode
+		 */
+		void SetMode( LineBatchMode mode ) { mMode = mode; }
+
+		/**
+		 * @brief Returns the submission mode
+		 */
+		LineBatchMode GetMode() const { return mMode; }
+
+		/**
+		 * @brief Returns the number of SDL draw calls the last flush issued.
+		 */
+		int GetDrawCallCount() const { return mDrawCalls; }
+
+		/**
+		 * @brief Returns the number of lines the last flush drew (an unbatched renderer issues one call per line).
+		 */
+		int GetLineCount() const { return mLines; }
+
+	private:
+		// The polygons of a single color
+		struct ColorBatch
+		{
+			// The polygons color
+			SDL_Color mColor;
+			// The polygons vertices, every polygon repeats its first vertex at its end (written at flush)
+			std::vector<SDL_FPoint> mPoints;
+			// One past the last vertex of every polygon
+			std::vector<int> mPolygonEnds;
+		};
+
+		/**
+		 * @brief Returns the batch of a color, creating it if needed.
+		 */
+		ColorBatch& GetColorBatch( const SDL_Color& color );
+
+		/**
+		 * @brief Submits the batch with a single SDL_RenderGeometry call.
+		 * @return false if the renderer couldn't draw the geometry.
+		 */
+		bool FlushGeometry( SDL_Renderer* renderer );
+
+		/**
+		 * @brief Submits the batch with a SDL_RenderDrawLinesF call per polygon.
+		 */
+		void FlushLines( SDL_Renderer* renderer );
+
+	private:
+		// The batched polygons, grouped by color (a frame only has a handful of colors)
+		std::vector<ColorBatch> mBatches;
+		// Number of batches in use this frame (the others keep their memory for the next frames)
+		std::size_t mUsedBatches = 0;
+
+		// Thin quads vertices for the geometry mode
+		std::vector<SDL_Vertex> mVertices;
+		// Thin quads indices for the geometry mode
+		std::vector<int> mIndices;
+
+		// The submission mode
+		LineBatchMode mMode = LineBatchMode::Geometry;
+
+		// Draw calls issued by the last flush
+		int mDrawCalls = 0;
+		// Lines drawn by the last flush
+		int mLines = 0;
+	};
+}
@@ -0,0 +1,77 @@
+#include "NullAudioBackend.hpp"
+
+namespace venture
+{
+	NullAudioBackend::NullAudioBackend()
+		: mStart( std::chrono::steady_clock::now() )
+	{}
+
+	SoundHandle NullAudioBackend::LoadSound( const std::string& path, int volume )
+	{
+		auto it = mHandles.find( path );
+		if ( it != mHandles.end() )
+		{
+			return it->second;
+		}
+
+		mPaths.push_back( path );
+		mVolumes.push_back( volume );
+		SoundHandle handle = static_cast< SoundHandle >( mPaths.size() - 1 );
+		mHandles.emplace( path, handle );
+		return handle;
+	}
+
+	int NullAudioBackend::AllocateChannels( int count )
+	{
+		mLooping.assign( count, false );
+		return count;
+	}
+
+	void NullAudioBackend::Play( int channel, SoundHandle sound, int loops, float gain )
+	{
+		mCalls.push_back( { CallType::Play, Now(), channel, sound, loops, gain, 0, 0, 0 } );
+		if ( channel >= 0 && channel < static_cast< int >( mLooping.size() ) )
+		{
+			mLooping[ channel ] = ( loops < 0 );
+		}
+	}
+
+	void NullAudioBackend::SetPosition( int channel, uint8_t left, uint8_t right, uint8_t distance )
+	{
+		mCalls.push_back( { CallType::Position, Now(), channel, INVALID_SOUND, 0, 0.f, left, right, distance } );
+	}
+
+	void NullAudioBackend::Halt( int channel )
+	{
+		mCalls.push_back( { CallType::Halt, Now(), channel, INVALID_SOUND, 0, 0.f, 0, 0, 0 } );
+		if ( channel < 0 )
+		{
+			mLooping.assign( mLooping.size(), false );
+		}
+		else if ( channel < static_cast< int >( mLooping.size() ) )
+		{
+			mLooping[ channel ] = false;
+		}
+	}
+
+	bool NullAudioBackend::IsPlaying( int channel ) const
+	{
+		return channel >= 0 && channel < static_cast< int >( mLooping.size() ) && mLooping[ channel ];
+	}
+
+	const std::string& NullAudioBackend::GetSoundPath( SoundHandle sound ) const
+	{
+		static const std::string unknown;
+		return ( sound >= 0 && sound < static_cast< SoundHandle >( mPaths.size() ) ) ? mPaths[ sound ] : unknown;
+	}
+
+	int NullAudioBackend::GetSoundVolume( SoundHandle sound ) const
+	{
+		return ( sound >= 0 && sound < static_cast< SoundHandle >( mVolumes.size() ) ) ? mVolumes[ sound ] : 0;
+	}
+
+	double NullAudioBackend::Now() const
+	{
+		return std::chrono::duration<double>( std::chrono::steady_clock::now() - mStart ).count();
+	}
+}
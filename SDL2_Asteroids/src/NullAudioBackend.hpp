@@ -0,0 +1,110 @@
+/**
+ * @class NullAudioBackend
+ * @brief An audio backend that plays nothing, and records the calls it would have made.
+ *
+ * Used when no audio device can be opened, or when ASTEROIDS_NULL_AUDIO is set (headless and
+ * automated runs). Sounds are never read or decoded, loading one only hands out a handle.
+ * Every play and halt is recorded with a timestamp, so tests can assert on what was played.
+ *
+ * Example usage:
+ * @code
+ * venture::NullAudioBackend audio;
+ * venture::SoundHandle hit = audio.LoadSound( hitPath, MIX_MAX_VOLUME );
+ * audio.Play( 3, hit, 0, 1.f );
+ * assert( audio.GetCalls().back().mType == venture::NullAudioBackend::CallType::Play );
+ * @endcode
+ */
+
+#pragma once
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AudioBackend.hpp"
+
+namespace venture
+{
+	class NullAudioBackend : public IAudioBackend
+	{
+	public:
+		// The kind of a recorded call
+		enum class CallType
+		{
+			Play,
+			Position,
+			Halt,
+		};
+
+		// A recorded call
+		struct Call
+		{
+			CallType mType;
+			// Seconds since the backend was created
+			double mTime;
+			int mChannel;
+			// Play only (INVALID_SOUND otherwise)
+			SoundHandle mSound;
+			int mLoops;
+			float mGain;
+			// Position only
+			uint8_t mLeft;
+			uint8_t mRight;
+			uint8_t mDistance;
+		};
+
+		NullAudioBackend();
+
+		const char* GetName() const override { return "Null"; }
+		bool DecodesSounds() const override { return false; }
+		SoundHandle LoadSound( const std::string& path, int volume ) override;
+		int AllocateChannels( int count ) override;
+		void Play( int channel, SoundHandle sound, int loops, float gain ) override;
+		void SetPosition( int channel, uint8_t left, uint8_t right, uint8_t distance ) override;
+		void Halt( int channel ) override;
+		bool IsPlaying( int channel ) const override;
+
+		/// Recorded calls
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the recorded calls, oldest first.
+		 */
+		const std::vector<Call>& GetCalls() const { return mCalls; }
+
+		/**
+		 * @brief Forgets the recorded calls.
+		 */
+		void ClearCalls() { mCalls.clear(); }
+
+		/**
+		 * @brief Returns the path a handle was loaded from (empty for an unknown handle).
+		 */
+		const std::string& GetSoundPath( SoundHandle sound ) const;
+
+		/**
+		 * @brief Returns the volume a handle was loaded with (0 for an unknown handle).
+		 */
+		int GetSoundVolume( SoundHandle sound ) const;
+
+	private:
+		/**
+		 * @brief Returns the seconds elapsed since the backend was created.
+		 */
+		double Now() const;
+
+	private:
+		// When the backend was created
+		std::chrono::steady_clock::time_point mStart;
+		// The loaded paths, indexed by handle
+		std::vector<std::string> mPaths;
+		// The volumes the sounds were loaded with, indexed by handle
+		std::vector<int> mVolumes;
+		// The handles, keyed by path
+		std::unordered_map<std::string, SoundHandle> mHandles;
+		// Channels looping a sound (one shots end right away, nothing is played)
+		std::vector<bool> mLooping;
+		// The recorded calls
+		std::vector<Call> mCalls;
+	};
+}
@@ -0,0 +1,181 @@
+#include "PerfHud.h"
+#include "Game.h"
+#include "FontManager.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+const float PerfHud::TEXT_REFRESH_INTERVAL = 0.25f;
+const double PerfHud::RENDER_BUDGET_MS = 0.1;
+
+namespace
+{
+	// The panel's layout
+	const float PANEL_WIDTH = 240.f;
+	const float PANEL_X = SCREEN_WIDTH - PANEL_WIDTH - 10.f;
+	const float PANEL_Y = 10.f;
+	const float PADDING = 6.f;
+	const int TEXT_LINES = 7;
+	const float GRAPH_HEIGHT = 60.f;
+	// The frame time at the top of the graph, and the 60 fps line
+	const float GRAPH_MAX_MS = 1000.f / 30.f;
+	const float TARGET_MS = 1000.f / 60.f;
+
+	void AddQuad( std::vector<SDL_Vertex>& vertices, std::vector<int>& indices,
+				  float x0, float y0, float x1, float y1, const SDL_Color& color )
+	{
+		int first = static_cast< int >( vertices.size() );
+		vertices.push_back( { { x0, y0 }, color, { 0.f, 0.f } } );
+		vertices.push_back( { { x1, y0 }, color, { 0.f, 0.f } } );
+		vertices.push_back( { { x0, y1 }, color, { 0.f, 0.f } } );
+		vertices.push_back( { { x1, y1 }, color, { 0.f, 0.f } } );
+
+		indices.push_back( first );
+		indices.push_back( first + 1 );
+		indices.push_back( first + 2 );
+		indices.push_back( first + 1 );
+		indices.push_back( first + 3 );
+		indices.push_back( first + 2 );
+	}
+}
+
+void PerfHud::AddFrame( const PerfHudFrame& frame )
+{
+	mFrameTimes[ mHistoryHead ] = frame.mFrameMs;
+	mHistoryHead = ( mHistoryHead + 1 ) % HISTORY_SIZE;
+	mHistoryCount = std::min( mHistoryCount + 1, static_cast< int >( HISTORY_SIZE ) );
+	mLastFrame = frame;
+	mTextAge += frame.mFrameMs / 1000.f;
+}
+
+int PerfHud::Render( SDL_Renderer* renderer )
+{
+	if ( !mVisible )
+	{
+		return 0;
+	}
+
+	ALLOCATION_TAG( "Hud" );
+	Uint64 renderStart = SDL_GetPerformanceCounter();
+
+	bool loadingFont = ( mGlyphAtlas == nullptr );
+	if ( loadingFont )
+	{
+		mGlyphAtlas = FontManager::get()->GetGlyphAtlas( renderer, FontManager::GetDefaultFontPath(), FONT_SIZE );
+	}
+
+	if ( mTextAge >= TEXT_REFRESH_INTERVAL )
+	{
+		LayoutText();
+		mTextAge = 0.f;
+	}
+	BuildGraph();
+
+	// Untextured geometry blends with the renderer's draw blend mode, the panel is translucent
+	int drawCalls = 0;
+	SDL_BlendMode blendMode;
+	SDL_GetRenderDrawBlendMode( renderer, &blendMode );
+	SDL_SetRenderDrawBlendMode( renderer, SDL_BLENDMODE_BLEND );
+	SDL_RenderGeometry( renderer, nullptr, mGraphVertices.data(), static_cast< int >( mGraphVertices.size() ),
+						mGraphIndices.data(), static_cast< int >( mGraphIndices.size() ) );
+	SDL_SetRenderDrawBlendMode( renderer, blendMode );
+	++drawCalls;
+
+	if ( mGlyphAtlas != nullptr && !mTextIndices.empty() )
+	{
+		SDL_RenderGeometry( renderer, mGlyphAtlas->GetTexture(), mTextVertices.data(), static_cast< int >( mTextVertices.size() ),
+							mTextIndices.data(), static_cast< int >( mTextIndices.size() ) );
+		++drawCalls;
+	}
+
+	mRenderTime = FrameTimings::ElapsedMs( renderStart );
+	if ( !loadingFont )
+	{
+		mMaxRenderTime = std::max( mMaxRenderTime, mRenderTime );
+		if ( mRenderTime > RENDER_BUDGET_MS && !mWarnedOverBudget )
+		{
+			printf( "(PerfHud): Rendering the HUD took %.3f ms, over its %.1f ms budget\n", mRenderTime, RENDER_BUDGET_MS );
+			mWarnedOverBudget = true;
+		}
+	}
+	return drawCalls;
+}
+
+void PerfHud::LayoutText()
+{
+	mTextVertices.clear();
+	mTextIndices.clear();
+	if ( mGlyphAtlas == nullptr )
+	{
+		return;
+	}
+
+	// The frame rate is averaged over the graph's frames (the recorded ones, the ring starts empty)
+	float totalMs = 0.f;
+	for ( float frameMs : mFrameTimes )
+	{
+		totalMs += frameMs;
+	}
+	float averageMs = mHistoryCount > 0 ? totalMs / mHistoryCount : 0.f;
+
+	char lines[ TEXT_LINES ][ 64 ];
+	snprintf( lines[ 0 ], sizeof( lines[ 0 ] ), "FPS %.1f (%.2f ms)", averageMs > 0.f ? 1000.f / averageMs : 0.f, averageMs );
+	snprintf( lines[ 1 ], sizeof( lines[ 1 ] ), "Asteroids %d  Bullets %d", mLastFrame.mAsteroids, mLastFrame.mBullets );
+	snprintf( lines[ 2 ], sizeof( lines[ 2 ] ), "Draw calls %d", mLastFrame.mDrawCalls );
+	snprintf( lines[ 3 ], sizeof( lines[ 3 ] ), "Collision pairs %d", mLastFrame.mCollisionPairs );
+	if ( mLastFrame.mAllocations >= 0 )
+	{
+		snprintf( lines[ 4 ], sizeof( lines[ 4 ] ), "Allocations %lld", static_cast< long long >( mLastFrame.mAllocations ) );
+	}
+	else
+	{
+		snprintf( lines[ 4 ], sizeof( lines[ 4 ] ), "Allocations n/a" );
+	}
+	if ( mLastFrame.mPacingFps > 0.f )
+	{
+		snprintf( lines[ 5 ], sizeof( lines[ 5 ] ), "Pacing %s %.0f  jitter %.2f ms", mLastFrame.mPacingMode, mLastFrame.mPacingFps, mLastFrame.mPacingJitterMs );
+	}
+	else
+	{
+		snprintf( lines[ 5 ], sizeof( lines[ 5 ] ), "Pacing %s  jitter %.2f ms", mLastFrame.mPacingMode, mLastFrame.mPacingJitterMs );
+	}
+	snprintf( lines[ 6 ], sizeof( lines[ 6 ] ), "HUD %.3f ms", mRenderTime );
+
+	const SDL_Color white = { 255, 255, 255, 255 };
+	float y = PANEL_Y + PADDING;
+	for ( const char* line : lines )
+	{
+		mGlyphAtlas->LayoutText( line, PANEL_X + PADDING, y, white, mTextVertices, mTextIndices );
+		y += static_cast< float >( mGlyphAtlas->GetLineHeight() );
+	}
+}
+
+void PerfHud::BuildGraph()
+{
+	mGraphVertices.clear();
+	mGraphIndices.clear();
+
+	float lineHeight = mGlyphAtlas != nullptr ? static_cast< float >( mGlyphAtlas->GetLineHeight() ) : 17.f;
+	float graphTop = PANEL_Y + PADDING + TEXT_LINES * lineHeight + PADDING;
+	float graphBottom = graphTop + GRAPH_HEIGHT;
+
+	// Panel
+	AddQuad( mGraphVertices, mGraphIndices, PANEL_X, PANEL_Y, PANEL_X + PANEL_WIDTH, graphBottom + PADDING, { 0, 0, 0, 180 } );
+
+	// A bar per frame, oldest on the left
+	const float barWidth = ( PANEL_WIDTH - 2.f * PADDING ) / HISTORY_SIZE;
+	for ( int i = 0; i < HISTORY_SIZE; ++i )
+	{
+		float frameMs = mFrameTimes[ ( mHistoryHead + i ) % HISTORY_SIZE ];
+		float height = std::min( frameMs / GRAPH_MAX_MS, 1.f ) * GRAPH_HEIGHT;
+		SDL_Color color = frameMs <= TARGET_MS ? SDL_Color{ 0, 200, 0, 255 }
+						: frameMs <= GRAPH_MAX_MS ? SDL_Color{ 230, 200, 0, 255 }
+						: SDL_Color{ 230, 40, 40, 255 };
+		float x = PANEL_X + PADDING + i * barWidth;
+		AddQuad( mGraphVertices, mGraphIndices, x, graphBottom - height, x + barWidth, graphBottom, color );
+	}
+
+	// The 60 fps line
+	float targetY = graphBottom - TARGET_MS / GRAPH_MAX_MS * GRAPH_HEIGHT;
+	AddQuad( mGraphVertices, mGraphIndices, PANEL_X + PADDING, targetY, PANEL_X + PANEL_WIDTH - PADDING, targetY + 1.f, { 255, 255, 255, 120 } );
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "GlyphAtlas.hpp"
+
+// A toggleable performance overlay: FPS, a rolling frame time graph and the frame's counters.
+// It draws with two SDL_RenderGeometry calls (the panel and graph, then the text), the graph's
+// vertices are rebuilt every frame but the text is only laid out again a few times per second.
+
+/**
+ * @brief The values the HUD shows for a frame
+ */
+struct PerfHudFrame
+{
+	// The frame's duration, in milliseconds
+	float mFrameMs = 0.f;
+	// Entities in the world
+	int mAsteroids = 0;
+	int mBullets = 0;
+	// SDL draw calls issued by the frame
+	int mDrawCalls = 0;
+	// Bullet/asteroid pairs the collision phase tested
+	int mCollisionPairs = 0;
+	// Allocations made during the frame, -1 when allocations aren't tracked
+	int64_t mAllocations = -1;
+	// The frame pacing mode (see FramePacer::GetModeName), the limiter's frame rate (0 when not limited)
+	// and the standard deviation of the frame intervals, in milliseconds
+	const char* mPacingMode = "";
+	float mPacingFps = 0.f;
+	float mPacingJitterMs = 0.f;
+};
+
+class PerfHud
+{
+public:
+	// The HUD's font size
+	static const int FONT_SIZE = 14;
+	// How long Render() may take, in milliseconds, it warns the first time it takes longer
+	static const double RENDER_BUDGET_MS;
+
+	/// Utility
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Shows or hides the HUD.
+	 */
+	void Toggle() { mVisible = !mVisible; }
+
+	/**
+	 * @brief Records a frame's values, cheap enough to call every frame even while the HUD is hidden.
+	 */
+	void AddFrame( const PerfHudFrame& frame );
+
+	/**
+	 * @brief Draws the HUD in the top right corner (does nothing while hidden).
+	 * @param renderer The renderer that handles the draw calls
+	 * @return The number of SDL draw calls issued.
+	 */
+	int Render( SDL_Renderer* renderer );
+
+	/// Getters
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Checks if the HUD is shown.
+	 */
+	bool IsVisible() const { return mVisible; }
+
+	/**
+	 * @brief Returns how long the last Render() took, in milliseconds.
+	 */
+	double GetRenderTime() const { return mRenderTime; }
+
+	/**
+	 * @brief Returns the longest Render() took, in milliseconds (the first one, which loads the font, isn't counted).
+	 */
+	double GetMaxRenderTime() const { return mMaxRenderTime; }
+
+private:
+	/**
+	 * @brief Lays the text out again from the latest frame.
+	 */
+	void LayoutText();
+
+	/**
+	 * @brief Rebuilds the panel and graph vertices.
+	 */
+	void BuildGraph();
+
+	// Frames kept for the graph
+	static const int HISTORY_SIZE = 120;
+	// Seconds between text refreshes
+	static const float TEXT_REFRESH_INTERVAL;
+
+	// Whether the HUD is shown
+	bool mVisible = false;
+
+	// The last frames' durations (a ring, mHistoryHead is the oldest)
+	std::array<float, HISTORY_SIZE> mFrameTimes = {};
+	int mHistoryHead = 0;
+	// Number of frames in the ring, up to HISTORY_SIZE
+	int mHistoryCount = 0;
+	// The latest frame's values
+	PerfHudFrame mLastFrame;
+
+	// The HUD's glyphs, fetched on the first render
+	std::shared_ptr<venture::GlyphAtlas> mGlyphAtlas;
+	// The text's quads
+	std::vector<SDL_Vertex> mTextVertices;
+	std::vector<int> mTextIndices;
+	// Seconds since the text was laid out
+	float mTextAge = TEXT_REFRESH_INTERVAL;
+
+	// The panel and graph's quads
+	std::vector<SDL_Vertex> mGraphVertices;
+	std::vector<int> mGraphIndices;
+
+	// Duration of the last Render() call, and of the longest one, in milliseconds
+	double mRenderTime = 0.0;
+	double mMaxRenderTime = 0.0;
+	// Set once Render() warned about going over RENDER_BUDGET_MS
+	bool mWarnedOverBudget = false;
+};
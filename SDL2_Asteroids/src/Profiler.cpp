@@ -0,0 +1,90 @@
+#include "Profiler.hpp"
+
+#ifdef ASTEROIDS_PROFILE
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace venture
+{
+	namespace
+	{
+		// A thread's ring buffer, only its thread writes to it
+		struct ThreadBuffer
+		{
+			// Index of the thread, used as the trace's tid
+			unsigned mThreadIndex;
+			// Total number of events written (the ring index is mWritten % EVENTS_PER_THREAD)
+			std::atomic<uint64_t> mWritten{ 0 };
+			Profiler::Event mEvents[ Profiler::EVENTS_PER_THREAD ];
+		};
+
+		// Every thread's buffer, registered on the thread's first zone and kept for the whole run
+		std::mutex sBuffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> sBuffers;
+
+		ThreadBuffer* RegisterThread()
+		{
+			std::lock_guard<std::mutex> lock( sBuffersMutex );
+			auto buffer = std::make_unique<ThreadBuffer>();
+			buffer->mThreadIndex = static_cast< unsigned >( sBuffers.size() );
+			sBuffers.push_back( std::move( buffer ) );
+			return sBuffers.back().get();
+		}
+
+		thread_local ThreadBuffer* tBuffer = nullptr;
+	}
+
+	std::chrono::steady_clock::time_point Profiler::GetEpoch()
+	{
+		static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+		return epoch;
+	}
+
+	void Profiler::Record( const char* name, uint64_t start, uint64_t end )
+	{
+		if ( tBuffer == nullptr )
+		{
+			tBuffer = RegisterThread();
+		}
+
+		// Single writer: fill the slot, then publish it
+		uint64_t written = tBuffer->mWritten.load( std::memory_order_relaxed );
+		tBuffer->mEvents[ written % EVENTS_PER_THREAD ] = { name, start, end };
+		tBuffer->mWritten.store( written + 1, std::memory_order_release );
+	}
+
+	bool Profiler::WriteChromeTrace( const std::string& path )
+	{
+		FILE* file = fopen( path.c_str(), "w" );
+		if ( file == nullptr )
+		{
+			printf( "Failed to write the trace %s!\n", path.c_str() );
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock( sBuffersMutex );
+		fprintf( file, "{\"traceEvents\":[\n" );
+		bool first = true;
+		for ( const auto& buffer : sBuffers )
+		{
+			uint64_t written = buffer->mWritten.load( std::memory_order_acquire );
+			uint64_t begin = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+			for ( uint64_t i = begin; i < written; ++i )
+			{
+				const Event& event = buffer->mEvents[ i % EVENTS_PER_THREAD ];
+				fprintf( file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+						 first ? "" : ",\n", event.mName, buffer->mThreadIndex,
+						 event.mStart / 1000.0, ( event.mEnd - event.mStart ) / 1000.0 );
+				first = false;
+			}
+		}
+		fprintf( file, "\n]}\n" );
+		fclose( file );
+		return true;
+	}
+}
+
+#endif
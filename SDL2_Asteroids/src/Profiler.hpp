@@ -0,0 +1,116 @@
+/**
+ * @class Profiler
+ * @brief Scoped timing zones recorded into per-thread ring buffers, exported as a Chrome trace.
+ *
+ * Every thread records its zones into its own fixed-size ring buffer, so recording never takes a lock:
+ * a zone is two clock reads and one store. The buffers can be written out as Chrome trace_event JSON
+ * (open it in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * The zones are only compiled in when ASTEROIDS_PROFILE is defined, otherwise the macros expand
+ * to nothing and cost nothing.
+ *
+ * Example usage:
+ * @code
+ * void Game::Update()
+ * {
+ *     PROFILE_ZONE( "Update" );
+ *     ...
+ * }
+ * PROFILE_WRITE_TRACE( "trace.json" ); // While no thread is recording
+ * @endcode
+ */
+
+#pragma once
+
+#ifdef ASTEROIDS_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace venture
+{
+	class Profiler
+	{
+	public:
+		// Events kept per thread, older events are overwritten
+		static const std::size_t EVENTS_PER_THREAD = 1 << 16;
+
+		// A recorded zone
+		struct Event
+		{
+			// The zone's name (a string literal)
+			const char* mName;
+			// Nanoseconds since the profiler started
+			uint64_t mStart;
+			uint64_t mEnd;
+		};
+
+		/**
+		 * @brief Returns the nanoseconds elapsed since the profiler started.
+		 */
+		static uint64_t Now()
+		{
+			return static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >(
+				std::chrono::steady_clock::now() - GetEpoch() ).count() );
+		}
+
+		/**
+		 * @brief Records a finished zone in the calling thread's ring buffer.
+		 */
+		static void Record( const char* name, uint64_t start, uint64_t end );
+
+		/**
+		 * @brief Writes every thread's recorded zones as Chrome trace_event JSON.
+		 * @note The recording threads must be idle (e.g. between frames or at shutdown).
+		 * @return true on success, false if the file couldn't be written.
+		 */
+		static bool WriteChromeTrace( const std::string& path );
+
+	private:
+		/**
+		 * @brief Returns the time the profiler started.
+		 */
+		static std::chrono::steady_clock::time_point GetEpoch();
+	};
+
+	/**
+	 * @brief Records the time between its construction and destruction as a zone.
+	 */
+	class ProfileZone
+	{
+	public:
+		explicit ProfileZone( const char* name )
+			: mName( name ), mStart( Profiler::Now() )
+		{}
+
+		~ProfileZone()
+		{
+			Profiler::Record( mName, mStart, Profiler::Now() );
+		}
+
+	private:
+		const char* mName;
+		uint64_t mStart;
+
+		ProfileZone( const ProfileZone& ) = delete;
+		ProfileZone& operator=( const ProfileZone& ) = delete;
+	};
+}
+
+#define PROFILE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_INNER( a, b )
+
+// Times the rest of the enclosing scope
+#define PROFILE_ZONE( name ) venture::ProfileZone PROFILE_CONCAT( profileZone, __LINE__ )( name )
+// Writes the recorded zones as a Chrome trace
+#define PROFILE_WRITE_TRACE( path ) venture::Profiler::WriteChromeTrace( path )
+
+#else
+
+#define PROFILE_ZONE( name ) ( ( void )0 )
+#define PROFILE_WRITE_TRACE( path ) ( ( void )( path ) )
+
+#endif
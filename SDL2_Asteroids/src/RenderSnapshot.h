@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+// An immutable copy of everything the renderer needs to draw a frame.
+// The simulation fills one at the end of every update (see Game::WriteRenderSnapshot),
+// the render side draws it while the simulation already works on the next tick.
+
+/**
+ * @brief What the renderer needs to draw an asteroid
+ */
+struct AsteroidRenderData
+{
+	// The asteroid's position
+	float mX, mY;
+	// The asteroid's rotation (in RAD)
+	float mRotation;
+	// The asteroid's size (model scale)
+	float mSize;
+	// Index of the asteroid's shape (see Asteroid::GetShape)
+	int mShapeId;
+	// The asteroid's color
+	SDL_Color mColor;
+};
+
+struct RenderSnapshot
+{
+	// The simulation tick that wrote the snapshot (0 before the first one)
+	uint64_t mTick = 0;
+
+	// The asteroids to draw
+	std::vector<AsteroidRenderData> mAsteroids;
+
+	// Bullets x positions
+	std::vector<float> mBulletsX;
+	// Bullets y positions
+	std::vector<float> mBulletsY;
+	// Bullets radii
+	std::vector<float> mBulletsSize;
+
+	// The ship's position
+	float mShipX = 0.f, mShipY = 0.f;
+	// The ship's rotation (in RAD)
+	float mShipRotation = 0.f;
+	// The ship's color
+	SDL_Color mShipColor = { 0, 0, 0, 0 };
+
+	// HUD values
+	// Is there a ship in the snapshot (false until the first update)
+	bool mHasShip = false;
+	// Is the ship dead
+	bool mShipDead = false;
+	// Did the player win
+	bool mPlayerWon = false;
+	// The player's score
+	int mScore = 0;
+};
@@ -0,0 +1,227 @@
+#include "Scenario.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	// A stress scenario: the ship flies and survives on its own for 30 seconds, over the same asteroids every run
+	Scenario MakeStressPreset( const char* name, int asteroids, int minSize, int maxSize, float fireRate )
+	{
+		Scenario scenario;
+		scenario.mName = name;
+		scenario.mMinAsteroids = asteroids;
+		scenario.mMaxAsteroids = asteroids;
+		scenario.mMinSize = minSize;
+		scenario.mMaxSize = maxSize;
+		scenario.mFireRate = fireRate;
+		scenario.mAutopilot = true;
+		scenario.mInvincible = true;
+		scenario.mDuration = 30.f;
+		scenario.mSeed = 1;
+		return scenario;
+	}
+
+	bool ParseInt( const std::string& text, int& outValue )
+	{
+		char* end = nullptr;
+		long value = std::strtol( text.c_str(), &end, 10 );
+		if ( text.empty() || *end != '\0' || value < 0 )
+		{
+			return false;
+		}
+		outValue = static_cast< int >( value );
+		return true;
+	}
+
+	bool ParseFloat( const std::string& text, float& outValue )
+	{
+		char* end = nullptr;
+		float value = std::strtof( text.c_str(), &end );
+		if ( text.empty() || *end != '\0' || value < 0.f )
+		{
+			return false;
+		}
+		outValue = value;
+		return true;
+	}
+
+	bool ParseBool( const std::string& text, bool& outValue )
+	{
+		if ( text == "1" || text == "true" || text == "on" )
+		{
+			outValue = true;
+			return true;
+		}
+		if ( text == "0" || text == "false" || text == "off" )
+		{
+			outValue = false;
+			return true;
+		}
+		return false;
+	}
+
+	// Parses "n" or "min-max"
+	bool ParseRange( const std::string& text, int& outMin, int& outMax )
+	{
+		std::size_t dash = text.find( '-' );
+		if ( dash == std::string::npos )
+		{
+			if ( !ParseInt( text, outMin ) )
+			{
+				return false;
+			}
+			outMax = outMin;
+			return true;
+		}
+
+		int min = 0;
+		int max = 0;
+		if ( !ParseInt( text.substr( 0, dash ), min ) || !ParseInt( text.substr( dash + 1 ), max ) || min > max )
+		{
+			return false;
+		}
+		outMin = min;
+		outMax = max;
+		return true;
+	}
+}
+
+const std::vector<Scenario>& Scenario::GetPresets()
+{
+	static const std::vector<Scenario> presets = {
+		Scenario(),
+		MakeStressPreset( "stress-15", 15, 24, 96, 0.f ),
+		MakeStressPreset( "stress-100", 100, 24, 96, 0.f ),
+		MakeStressPreset( "stress-1k", 1000, 16, 64, 0.f ),
+		MakeStressPreset( "stress-10k", 10000, 8, 32, 0.f ),
+		MakeStressPreset( "stress-100k", 100000, 4, 16, 0.f ),
+		MakeStressPreset( "bullet-storm", 1000, 16, 64, 60.f ),
+	};
+	return presets;
+}
+
+const Scenario* Scenario::FindPreset( const std::string& name )
+{
+	for ( const Scenario& preset : GetPresets() )
+	{
+		if ( preset.mName == name )
+		{
+			return &preset;
+		}
+	}
+	return nullptr;
+}
+
+bool Scenario::Parse( const std::string& spec )
+{
+	bool valid = true;
+	std::istringstream lines( spec );
+	std::string line;
+	while ( std::getline( lines, line ) )
+	{
+		line = line.substr( 0, line.find( '#' ) );
+		for ( char& c : line )
+		{
+			c = ( c == ',' ) ? ' ' : c;
+		}
+
+		std::istringstream pairs( line );
+		std::string pair;
+		while ( pairs >> pair )
+		{
+			std::size_t equals = pair.find( '=' );
+			std::string key = pair.substr( 0, equals );
+			std::string value = ( equals == std::string::npos ) ? std::string() : pair.substr( equals + 1 );
+
+			bool parsed = false;
+			if ( key == "preset" )
+			{
+				const Scenario* preset = FindPreset( value );
+				if ( preset != nullptr )
+				{
+					*this = *preset;
+					parsed = true;
+				}
+			}
+			else if ( key == "name" )
+			{
+				mName = value;
+				parsed = !value.empty();
+			}
+			else if ( key == "asteroids" )
+			{
+				parsed = ParseRange( value, mMinAsteroids, mMaxAsteroids );
+			}
+			else if ( key == "sizes" )
+			{
+				parsed = ParseRange( value, mMinSize, mMaxSize ) && mMinSize > 0;
+			}
+			else if ( key == "fire_rate" )
+			{
+				parsed = ParseFloat( value, mFireRate );
+			}
+			else if ( key == "autopilot" )
+			{
+				parsed = ParseBool( value, mAutopilot );
+			}
+			else if ( key == "invincible" )
+			{
+				parsed = ParseBool( value, mInvincible );
+			}
+			else if ( key == "duration" )
+			{
+				parsed = ParseFloat( value, mDuration );
+			}
+			else if ( key == "seed" )
+			{
+				int seed = 0;
+				parsed = ParseInt( value, seed );
+				mSeed = parsed ? static_cast< unsigned >( seed ) : mSeed;
+			}
+
+			if ( !parsed )
+			{
+				printf( "Invalid scenario setting '%s'!\n", pair.c_str() );
+				valid = false;
+			}
+		}
+	}
+	return valid;
+}
+
+bool Scenario::Load( const std::string& source, Scenario& outScenario )
+{
+	if ( const Scenario* preset = FindPreset( source ) )
+	{
+		outScenario = *preset;
+		return true;
+	}
+
+	Scenario scenario;
+	std::ifstream file( source );
+	if ( file )
+	{
+		std::stringstream contents;
+		contents << file.rdbuf();
+		scenario.mName = source;
+		if ( !scenario.Parse( contents.str() ) )
+		{
+			return false;
+		}
+	}
+	else if ( source.find( '=' ) == std::string::npos )
+	{
+		printf( "Unknown scenario '%s'!\n", source.c_str() );
+		return false;
+	}
+	else if ( !scenario.Parse( source ) )
+	{
+		return false;
+	}
+
+	outScenario = scenario;
+	return true;
+}
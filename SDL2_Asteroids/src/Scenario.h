@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// A scenario describes the world RestartGame builds: how many asteroids, how big, how the ship behaves
+// and for how long the game runs. Scenarios make heavy scenes repeatable, so every performance change
+// can be measured against the same loads.
+//
+// A scenario is written as key=value pairs, separated by spaces, commas or new lines ('#' starts a comment):
+//
+// @code
+// preset=stress-1k       # Start from a preset (must come first, it resets every other key)
+// asteroids=500-800      # Asteroid count, a number or a min-max range
+// sizes=12-48            # Asteroid size range
+// fire_rate=30           # Bullets the ship fires per second on its own, 0 leaves it to the player
+// autopilot=1            # The ship turns on its own and ignores the keyboard
+// invincible=1           # Asteroids don't kill the ship
+// duration=30            # Seconds before the game quits, 0 runs until the window is closed
+// seed=42                # Seeds the asteroids, 0 picks a random seed every restart
+// @endcode
+
+struct Scenario
+{
+	// The scenario's name
+	std::string mName = "classic";
+	// Asteroid count range
+	int mMinAsteroids = 15;
+	int mMaxAsteroids = 35;
+	// Asteroid size range
+	int mMinSize = 24;
+	int mMaxSize = 96;
+	// Bullets fired per second without input, 0 for none
+	float mFireRate = 0.f;
+	// Whether the ship flies on its own
+	bool mAutopilot = false;
+	// Whether the ship survives asteroid hits
+	bool mInvincible = false;
+	// Seconds before the game quits, 0 for no limit
+	float mDuration = 0.f;
+	// Random seed of the asteroids, 0 for a random one
+	unsigned mSeed = 0;
+
+	/**
+	 * @brief Returns the built-in scenarios, from the classic game (15 asteroids) up to 100k asteroids.
+	 */
+	static const std::vector<Scenario>& GetPresets();
+
+	/**
+	 * @brief Finds a built-in scenario by name.
+	 * @return The preset, or nullptr if there is no preset with that name.
+	 */
+	static const Scenario* FindPreset( const std::string& name );
+
+	/**
+	 * @brief Applies a scenario spec (key=value pairs) on top of this scenario.
+	 * @param spec The spec's text.
+	 * @return false if the spec has an unknown key or an invalid value (the valid keys are still applied).
+	 */
+	bool Parse( const std::string& spec );
+
+	/**
+	 * @brief Loads a scenario from a preset name, a spec file path or an inline spec, in that order.
+	 * @param source The preset name, file path or spec.
+	 * @param outScenario Receives the scenario.
+	 * @return false if the source couldn't be parsed.
+	 */
+	static bool Load( const std::string& source, Scenario& outScenario );
+};
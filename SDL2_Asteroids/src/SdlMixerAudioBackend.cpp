@@ -0,0 +1,64 @@
+#include "SdlMixerAudioBackend.hpp"
+#include "AssetCache.hpp"
+
+#include <algorithm>
+
+namespace venture
+{
+	SoundHandle SdlMixerAudioBackend::LoadSound( const std::string& path, int volume )
+	{
+		auto it = mHandles.find( path );
+		if ( it == mHandles.end() )
+		{
+			std::shared_ptr<Mix_Chunk> chunk = AssetCache::get()->LoadSound( path );
+			if ( chunk == nullptr )
+			{
+				return INVALID_SOUND;
+			}
+
+			mSounds.push_back( std::move( chunk ) );
+			mVolumes.push_back( volume );
+			it = mHandles.emplace( path, static_cast< SoundHandle >( mSounds.size() - 1 ) ).first;
+		}
+
+		mVolumes[ it->second ] = volume;
+		Mix_VolumeChunk( mSounds[ it->second ].get(), volume );
+		return it->second;
+	}
+
+	int SdlMixerAudioBackend::AllocateChannels( int count )
+	{
+		return Mix_AllocateChannels( count );
+	}
+
+	void SdlMixerAudioBackend::Play( int channel, SoundHandle sound, int loops, float gain )
+	{
+		if ( sound < 0 || sound >= static_cast< SoundHandle >( mSounds.size() ) )
+		{
+			return;
+		}
+
+		// The gain goes through the chunk's volume, the channels stay at full volume like SDL_mixer's default.
+		// The chunk is shared, the voices of the same sound still playing follow its volume too.
+		Mix_VolumeChunk( mSounds[ sound ].get(), std::min( MIX_MAX_VOLUME, static_cast< int >( mVolumes[ sound ] * gain ) ) );
+		Mix_Volume( channel, MIX_MAX_VOLUME );
+		Mix_PlayChannel( channel, mSounds[ sound ].get(), loops );
+	}
+
+	void SdlMixerAudioBackend::SetPosition( int channel, uint8_t left, uint8_t right, uint8_t distance )
+	{
+		// Both effects unregister themselves when set back to their neutral values
+		Mix_SetPanning( channel, left, right );
+		Mix_SetDistance( channel, distance );
+	}
+
+	void SdlMixerAudioBackend::Halt( int channel )
+	{
+		Mix_HaltChannel( channel );
+	}
+
+	bool SdlMixerAudioBackend::IsPlaying( int channel ) const
+	{
+		return Mix_Playing( channel ) != 0;
+	}
+}
@@ -0,0 +1,40 @@
+/**
+ * @class SdlMixerAudioBackend
+ * @brief Plays the game's sounds with SDL_mixer, the sounds are loaded through the AssetCache.
+ *
+ * @note The audio device must be opened (Mix_OpenAudio) before the backend is used.
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL_mixer.h>
+
+#include "AudioBackend.hpp"
+
+namespace venture
+{
+	class SdlMixerAudioBackend : public IAudioBackend
+	{
+	public:
+		const char* GetName() const override { return "SDL_mixer"; }
+		bool DecodesSounds() const override { return true; }
+		SoundHandle LoadSound( const std::string& path, int volume ) override;
+		int AllocateChannels( int count ) override;
+		void Play( int channel, SoundHandle sound, int loops, float gain ) override;
+		void SetPosition( int channel, uint8_t left, uint8_t right, uint8_t distance ) override;
+		void Halt( int channel ) override;
+		bool IsPlaying( int channel ) const override;
+
+	private:
+		// The loaded sounds, indexed by handle
+		std::vector<std::shared_ptr<Mix_Chunk>> mSounds;
+		// The volumes the sounds were loaded with, indexed by handle
+		std::vector<int> mVolumes;
+		// The handles, keyed by path
+		std::unordered_map<std::string, SoundHandle> mHandles;
+	};
+}
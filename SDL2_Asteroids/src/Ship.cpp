@@ -1,6 +1,7 @@
 #include "Ship.h"
 #include "Game.h"
 #include "InputManager.hpp"
+#include "Profiler.hpp"
 
 #include <iostream>
 #include <algorithm>
@@ -8,18 +9,11 @@
 
 const float Ship::topPointOffset = 25.0f;
 const float Ship::mRotationSpeed = 5.0f;
+const float Ship::BULLET_MARGIN = 100.0f;
 
 Ship::Ship( const glm::vec2& position, const SDL_Color& color )
 	: mColor( color ), mIsDead(false)
 {
-	// A Simple Isosceles Triangle
-	vecModelShip =
-	{
-		{  0.0f, -25.0f },
-		{ -12.5f, +12.5f },
-		{ +12.5f, +12.5f }
-	};
-
 	mAccelerationFactor = 100.f;
 
 	mShip.mPosition = position;
@@ -36,217 +30,278 @@ void Ship::ProcessInput()
 {
 	auto game = Game::GetInstance();
 	auto input = venture::InputManager::get();
+	bool thrusting = false;
 	if ( !mIsDead )
 	{
-		// Rotation
-		if ( input->isKeyDown( SDL_SCANCODE_LEFT ) )
-
-			mShip.mRotation -= mRotationSpeed * game->GetDeltaTime();
+		if ( mAutopilot )
+		{
+			// Turns in a slow circle, the fire rate decides when it shoots
+			mShip.mRotation += mRotationSpeed * 0.25f * game->GetDeltaTime();
+		}
+		else
+		{
+			// Rotation
+			if ( input->isKeyDown( SDL_SCANCODE_LEFT ) )
 
-		if ( input->isKeyDown( SDL_SCANCODE_RIGHT ) )
-			mShip.mRotation += mRotationSpeed * game->GetDeltaTime();
+				mShip.mRotation -= mRotationSpeed * game->GetDeltaTime();
 
+			if ( input->isKeyDown( SDL_SCANCODE_RIGHT ) )
+				mShip.mRotation += mRotationSpeed * game->GetDeltaTime();
 
-		// Acceleration
-		if ( input->isKeyDown( SDL_SCANCODE_UP ) )
-		{
-			mShip.mVelocity.x += sin( mShip.mRotation ) * mAccelerationFactor * game->GetDeltaTime();
-			mShip.mVelocity.y += -cos( mShip.mRotation ) * mAccelerationFactor * game->GetDeltaTime();
 
-			mHoverChannel = Mix_PlayChannel( 1, mHoverSound, 0 );
-		}
+			// Acceleration
+			thrusting = input->isKeyDown( SDL_SCANCODE_UP );
+			if ( thrusting )
+			{
+				mShip.mVelocity.x += sin( mShip.mRotation ) * mAccelerationFactor * game->GetDeltaTime();
+				mShip.mVelocity.y += -cos( mShip.mRotation ) * mAccelerationFactor * game->GetDeltaTime();
+			}
 
-		if ( input->isKeyReleased( SDL_SCANCODE_UP ) )
-		{
-			Mix_HaltChannel( mHoverChannel );
+			// Spawn Bullets with space key: every press of the frame fires (a tap between two frames too),
+			// the bullet starts as far along its path as it flew since the press
+			for ( std::size_t i = 0; i < input->GetFrameEventCount() && !input->IsKeyboardLocked(); ++i )
+			{
+				const InputEvent& event = input->GetFrameEvent( i );
+				if ( event.mType == InputEventType::KEY_DOWN && event.mScancode == SDL_SCANCODE_SPACE )
+				{
+					game->GetVoiceManager().Play( mLaserSound, VoiceManager::PRIORITY_HIGH );
+					SpawnBullet( std::min( input->GetEventAge( event ), game->GetDeltaTime() ) );
+				}
+			}
 		}
 
-		// Spawn Bullets with space key
-		if ( input->isKeyPressed( SDL_SCANCODE_SPACE ) )
+		// Automatic fire, a frame may fire several bullets (they share one laser sound)
+		if ( mFireRate > 0.f )
 		{
-			mLaserChannel = Mix_PlayChannel( 2, mLaserSound, 0 );
-			SpawnBullet();
+			bool fired = false;
+			mFireCooldown -= game->GetDeltaTime();
+			while ( mFireCooldown <= 0.f )
+			{
+				// The bullet was due -mFireCooldown seconds ago
+				SpawnBullet( -mFireCooldown );
+				mFireCooldown += 1.f / mFireRate;
+				fired = true;
+			}
+			if ( fired )
+			{
+				game->GetVoiceManager().Play( mLaserSound, VoiceManager::PRIORITY_HIGH );
+			}
 		}
 	}
 
+	// The hover sound loops for as long as the ship accelerates
+	game->GetVoiceManager().SetLoop( mHoverSound, VoiceManager::PRIORITY_NORMAL, thrusting );
+
 }
 
 void Ship::Update( float deltaTime )
 {
-	MoveShip(deltaTime);
-
-	CheckAsteroidsCollision();
-	
-	UpdateBullets(deltaTime);
+	MoveShip( deltaTime );
 
+	// Bullets don't wrap, they keep flying until they're past the asteroids wrapping margin
+	Kinematics::Integrate( mBullets, deltaTime, false );
+	for ( std::size_t i = 0; i < mBullets.Size(); )
+	{
+		float x = mBullets.mPositionsX[ i ];
+		float y = mBullets.mPositionsY[ i ];
+		if ( x < -BULLET_MARGIN || x > SCREEN_WIDTH + BULLET_MARGIN || y < -BULLET_MARGIN || y > SCREEN_HEIGHT + BULLET_MARGIN )
+		{
+			mBullets.SwapRemove( i );
+			continue;
+		}
+		++i;
+	}
+	mBulletHits.assign( mBullets.Size(), -1 );
 }
 
-void Ship::Render( SDL_Renderer* renderer )
+void Ship::Render( const RenderSnapshot& snapshot )
 {
 	auto game = Game::GetInstance();
-	SDL_SetRenderDrawColor( renderer, mColor.r, mColor.g, mColor.b, mColor.a );
-	game->DrawWireFrameModel( renderer, vecModelShip,
-							  mShip.mPosition.x, mShip.mPosition.y, mShip.mRotation );
+	game->DrawWireFrameModel( GetModel(), snapshot.mShipX, snapshot.mShipY, snapshot.mShipRotation, 1.0f, snapshot.mShipColor );
 
-	for ( auto& bullet : mBulletsVec )
+	// Queued in the circle atlas batch, every bullet is drawn with a single call
+	for ( std::size_t i = 0; i < snapshot.mBulletsX.size(); ++i )
 	{
-		game->DrawCircleFill( renderer, bullet.mPosition.x, bullet.mPosition.y, static_cast< float >( bullet.mSize ), SDL_Color( 255, 0, 0 ) );
+		game->DrawCircleFill( snapshot.mBulletsX[ i ], snapshot.mBulletsY[ i ], snapshot.mBulletsSize[ i ], SDL_Color( 255, 0, 0, 255 ) );
 	}
 
 }
 
+void Ship::WriteRenderSnapshot( RenderSnapshot& snapshot ) const
+{
+	snapshot.mShipX = mShip.mPosition.x;
+	snapshot.mShipY = mShip.mPosition.y;
+	snapshot.mShipRotation = mShip.mRotation;
+	snapshot.mShipColor = mColor;
+	snapshot.mShipDead = mIsDead;
+
+	snapshot.mBulletsX.assign( mBullets.mPositionsX.begin(), mBullets.mPositionsX.end() );
+	snapshot.mBulletsY.assign( mBullets.mPositionsY.begin(), mBullets.mPositionsY.end() );
+	snapshot.mBulletsSize.assign( mBullets.mSizes.begin(), mBullets.mSizes.end() );
+}
+
+const std::vector<std::pair<float, float>>& Ship::GetModel()
+{
+	// A Simple Isosceles Triangle
+	static const std::vector<std::pair<float, float>> model =
+	{
+		{  0.0f, -25.0f },
+		{ -12.5f, +12.5f },
+		{ +12.5f, +12.5f }
+	};
+	return model;
+}
+
 void Ship::Clean()
 {
-	vecModelShip.clear();
-	mBulletsVec.clear();
-
-	Mix_FreeChunk( mHoverSound );
-	mHoverSound = nullptr;
-	Mix_FreeChunk( mLaserSound );
-	mLaserSound = nullptr;
-	Mix_FreeChunk( mDeadSound );
-	mDeadSound = nullptr;
-	Mix_FreeChunk( mAsteroidHitSound );
-	mAsteroidHitSound = nullptr;
+	mBullets.Clear();
+
+	// The sounds stay loaded in the audio backend, only our handles are dropped
+	mHoverSound = INVALID_SOUND;
+	mLaserSound = INVALID_SOUND;
+	mDeadSound = INVALID_SOUND;
+	mAsteroidHitSound = INVALID_SOUND;
 }
 
 void Ship::MoveShip( float deltaTime )
 {
-	mShip.mPosition.x += mShip.mVelocity.x * deltaTime;
-	mShip.mPosition.y += mShip.mVelocity.y * deltaTime;
+	Kinematics::Integrate( mShip, deltaTime );
 }
 
-void Ship::MoveBullet( SpaceObject& bullet, float deltaTime )
+void Ship::HaltAllSounds()
 {
-	bullet.mPosition.x += bullet.mVelocity.x * deltaTime;
-	bullet.mPosition.y += bullet.mVelocity.y * deltaTime;
+	Game::GetInstance()->GetVoiceManager().HaltAll();
 }
 
-void Ship::HaltAllSounds()
+std::vector<std::string> Ship::GetSoundPaths()
 {
-	Mix_HaltChannel(mHoverChannel);
-	Mix_HaltChannel(mLaserChannel);
-	Mix_HaltChannel(mDeadChannel);
-	Mix_HaltChannel(mAsteroidHitChannel);
+	const std::string assets = std::string( SOLUTION_DIR ) + "Assets/";
+	return { assets + "spaceshipHover.wav", assets + "LaserShoot.wav", assets + "ShipDead.wav", assets + "AsteroidExplosion.wav" };
 }
 
 void Ship::LoadAndSetSFX()
 {
-	std::string hoverSoundSrc = std::string( SOLUTION_DIR ) + "Assets/spaceshipHover.wav";
-	mHoverSound = Mix_LoadWAV( hoverSoundSrc.c_str() );
-	if ( !mHoverSound )
+	const std::vector<std::string> soundPaths = GetSoundPaths();
+	IAudioBackend& audio = Game::GetInstance()->GetAudioBackend();
+
+	mHoverSound = audio.LoadSound( soundPaths[ 0 ], MIX_MAX_VOLUME * 10 );
+	if ( mHoverSound == INVALID_SOUND )
 	{
 		printf( "Failed to load the spaceship hover sound! , Error: %s", Mix_GetError() );
 	}
-	Mix_VolumeChunk( mHoverSound, MIX_MAX_VOLUME * 10 );
-	mHoverChannel = -1;
 
-	std::string laserSoundSrc = std::string( SOLUTION_DIR ) + "Assets/LaserShoot.wav";
-	mLaserSound = Mix_LoadWAV( laserSoundSrc.c_str() );
-	if ( !mLaserSound )
+	mLaserSound = audio.LoadSound( soundPaths[ 1 ], MIX_MAX_VOLUME / 7 );
+	if ( mLaserSound == INVALID_SOUND )
 	{
 		printf( "Failed to load the spaceship laser sound! , Error: %s", Mix_GetError() );
 	}
 
-	Mix_VolumeChunk( mLaserSound, MIX_MAX_VOLUME / 7 );
-	mLaserChannel = -1;
-
-	std::string deadSoundSrc = std::string( SOLUTION_DIR ) + "Assets/ShipDead.wav";
-	mDeadSound = Mix_LoadWAV( deadSoundSrc.c_str() );
-	if ( !mDeadSound )
+	mDeadSound = audio.LoadSound( soundPaths[ 2 ], MIX_MAX_VOLUME / 5 );
+	if ( mDeadSound == INVALID_SOUND )
 	{
 		printf( "Failed to load the spaceship hit sound! , Error: %s", Mix_GetError() );
 	}
 
-	Mix_VolumeChunk( mDeadSound, MIX_MAX_VOLUME / 5 );
-	mDeadChannel = -1;
-
-	std::string asteroidHitSoundSrc = std::string( SOLUTION_DIR ) + "Assets/AsteroidExplosion.wav";
-	mAsteroidHitSound = Mix_LoadWAV( asteroidHitSoundSrc.c_str() );
-	if ( !mAsteroidHitSound )
+	mAsteroidHitSound = audio.LoadSound( soundPaths[ 3 ], MIX_MAX_VOLUME / 8 );
+	if ( mAsteroidHitSound == INVALID_SOUND )
 	{
 		printf( "Failed to load the asteroid hit sound! , Error: %s", Mix_GetError() );
 	}
-
-	Mix_VolumeChunk( mAsteroidHitSound, MIX_MAX_VOLUME / 8 );
-	mAsteroidHitChannel = -1;
 }
 
-void Ship::CheckAsteroidsCollision()
+void Ship::CheckAsteroidsCollision( const Broadphase& asteroids )
 {
-	auto& asteroidsMap = Game::GetInstance()->GetAsteroidsMap();
+	if ( !mInvincible && IsCollidingWithAsteroid( asteroids ) )
+	{
+		auto& voices = Game::GetInstance()->GetVoiceManager();
+		voices.Play( mDeadSound, VoiceManager::PRIORITY_CRITICAL );
+		voices.SetLoop( mHoverSound, VoiceManager::PRIORITY_NORMAL, false );
+		SetIsDead( true );
+	}
+}
 
-	for ( auto asteroidIt = asteroidsMap.begin(); asteroidIt != asteroidsMap.end();)
+int Ship::FindBulletHits( const Broadphase& asteroids, std::size_t begin, std::size_t end )
+{
+	int pairs = 0;
+	for ( std::size_t i = begin; i < end; ++i )
 	{
-		Asteroid* asteroid = &asteroidIt->second;
-		if ( IsCollidingWithAsteroid( asteroid ) )
-		{
-			Mix_PlayChannel( 3, mDeadSound, 0 );
-			Mix_HaltChannel( mHoverChannel );
-			SetIsDead( true );
-			break;
-		}
-		++asteroidIt;
+		mBulletHits[ i ] = asteroids.FindFirstHit( mBullets.mPositionsX[ i ], mBullets.mPositionsY[ i ], &pairs );
 	}
+	return pairs;
 }
 
-void Ship::UpdateBullets( float deltaTime )
+void Ship::UpdateBullets()
 {
+	PROFILE_ZONE( "Ship::UpdateBullets" );
 	auto game = Game::GetInstance();
 	auto& asteroidsMap = game->GetAsteroidsMap();
 
-	for ( auto bulletIt = mBulletsVec.begin(); bulletIt != mBulletsVec.end();)
+	for ( std::size_t bulletIndex = 0; bulletIndex < mBullets.Size();)
 	{
-		bool bulletHit = false;
-		SpaceObject& bullet = *bulletIt;
-		MoveBullet( bullet, deltaTime );
-
-		for ( auto asteroidIt = asteroidsMap.begin(); asteroidIt != asteroidsMap.end();)
+		int hit = mBulletHits[ bulletIndex ];
+		if ( hit < 0 )
 		{
-			Asteroid& asteroid = asteroidIt->second;
+			++bulletIndex;
+			continue;
+		}
 
-			if ( game->IsPointInCircle( asteroid.GetPosition().x, asteroid.GetPosition().y, static_cast< float >( asteroid.GetSize() ), bullet.mPosition.x, bullet.mPosition.y ) )
-			{
-				game->AddScore( 1 );
-				Mix_PlayChannel( 4, mAsteroidHitSound, 0 );
-				auto& pos = asteroid.GetPosition();
-				if ( asteroid.GetSize() > 12 )
-				{
-					static double angle1 = static_cast< float >( rand() ) / RAND_MAX * 2.4f * M_PI;
-					static double angle2 = static_cast< float >( rand() ) / RAND_MAX * 1.7f * M_PI;
-					static double angle3 = static_cast< float >( rand() ) / RAND_MAX * 1.3f * M_PI;
-					static double angle4 = static_cast< float >( rand() ) / RAND_MAX * 2.8f * M_PI;
+		// Another bullet may have destroyed this asteroid earlier in the frame, the bullet keeps flying
+		auto asteroidIt = asteroidsMap.find( game->GetAsteroidId( hit ) );
+		if ( asteroidIt == asteroidsMap.end() )
+		{
+			++bulletIndex;
+			continue;
+		}
 
-					SpaceObject child1( pos, glm::vec2{ 35.0f * sin( angle1 ), 30.0f * cos( angle2 ) }, 1.5f, asteroid.GetSize() / 2 );
-					SpaceObject child2( pos, glm::vec2{ 35.0f * sin( angle3 ), 45.0f * cos( angle4 ) }, 0.8f, asteroid.GetSize() / 2 );
+		Asteroid& asteroid = asteroidIt->second;
+		game->AddScore( 1 );
+		// Many hits in one frame coalesce into a single (louder) voice, panned from where they happened
+		game->GetVoiceManager().PlayAt( mAsteroidHitSound, VoiceManager::PRIORITY_LOW,
+										mBullets.mPositionsX[ bulletIndex ], mBullets.mPositionsY[ bulletIndex ] );
+		// Removed before its children are added, adding may rehash the map (invalidating the iterator)
+		glm::vec2 pos = asteroid.GetPosition();
+		int size = asteroid.GetSize();
+		game->RemoveAsteroid( asteroidIt );
+		if ( size > 12 )
+		{
+			static double angle1 = static_cast< float >( rand() ) / RAND_MAX * 2.4f * M_PI;
+			static double angle2 = static_cast< float >( rand() ) / RAND_MAX * 1.7f * M_PI;
+			static double angle3 = static_cast< float >( rand() ) / RAND_MAX * 1.3f * M_PI;
+			static double angle4 = static_cast< float >( rand() ) / RAND_MAX * 2.8f * M_PI;
 
-					game->AddAsteroid( child1 );
-					game->AddAsteroid( child2 );
-					asteroid.SetPositionX( -300.f );
-				}
-				asteroidsMap.erase( asteroidIt );
-				bulletHit = true;
-				break;
-			}
-			++asteroidIt;
+			SpaceObject child1( pos, glm::vec2{ 35.0f * sin( angle1 ), 30.0f * cos( angle2 ) }, 1.5f, size / 2 );
+			SpaceObject child2( pos, glm::vec2{ 35.0f * sin( angle3 ), 45.0f * cos( angle4 ) }, 0.8f, size / 2 );
 
-		} // end of asteroids loop
+			game->AddAsteroid( child1 );
+			game->AddAsteroid( child2 );
+		}
 
-		if ( bulletHit )
-		{
+		// Keep the hits lined up with the bullets
+		mBulletHits[ bulletIndex ] = mBulletHits.back();
+		mBulletHits.pop_back();
+		mBullets.SwapRemove( bulletIndex );
+	}
+}
 
-			bulletIt = mBulletsVec.erase( bulletIt );
-		}
-		else
-		{
-			++bulletIt;
-		}
+void Ship::Reset( const glm::vec2& position )
+{
+	mIsDead = false;
+	mShip.mPosition = position;
+	mShip.mVelocity = { 0.f, 0.f };
+	mShip.mRotation = 0.0f;
+	mFireCooldown = 0.f;
 
-	} // end of bullets loop
+	mBullets.Clear();
+	mBulletHits.clear();
+}
 
+void Ship::AddBullet( const SpaceObject& bullet )
+{
+	mBullets.Push( bullet );
+	mBulletHits.push_back( -1 );
 }
 
-void Ship::SpawnBullet()
+void Ship::SpawnBullet( float age )
 {
 	glm::vec2 shipPosition = mShip.mPosition;
 	float shipRotation = mShip.mRotation;
@@ -257,16 +312,14 @@ void Ship::SpawnBullet()
 	float bulletX = shipPosition.x + topPointOffset * sinf( shipRotation );
 	float bulletY = shipPosition.y + topPointOffset * -cosf( shipRotation );
 
-	auto pos = glm::vec2{ bulletX, bulletY };
 	auto vel = glm::vec2{ mBulletSpeed * GetShipForwardVector() };
-	mBulletsVec.emplace_back( pos, vel, 0.f, 2 );
+	auto pos = glm::vec2{ bulletX, bulletY } + vel * age;
+	AddBullet( SpaceObject( pos, vel, 0.f, 2 ) );
 }
 
-bool Ship::IsCollidingWithAsteroid( Asteroid* asteroid )
+bool Ship::IsCollidingWithAsteroid( const Broadphase& asteroids ) const
 {
-	if ( !asteroid ) return false;  // Null check
-
-	for ( const auto& vertex : vecModelShip )
+	for ( const auto& vertex : GetModel() )
 	{
 		// Transform the vertex according to the ship's current position and rotation
 		float transformedX = vertex.first * cosf( mShip.mRotation ) - vertex.second * sinf( mShip.mRotation );
@@ -280,10 +333,8 @@ bool Ship::IsCollidingWithAsteroid( Asteroid* asteroid )
 		transformedX += mShip.mPosition.x;
 		transformedY += mShip.mPosition.y;
 
-		// Check if the transformed vertex is inside the asteroid
-		float dx = transformedX - asteroid->GetPosition().x;
-		float dy = transformedY - asteroid->GetPosition().y;
-		if ( sqrt( dx * dx + dy * dy ) < asteroid->GetSize() )
+		// Check if the transformed vertex is inside an asteroid
+		if ( asteroids.FindFirstHit( transformedX, transformedY ) >= 0 )
 		{
 			return true;  // Collision detected
 		}
@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -8,6 +10,10 @@
 
 #include "SpaceObject.h"
 #include "Asteroid.h"
+#include "Kinematics.h"
+#include "Broadphase.h"
+#include "RenderSnapshot.h"
+#include "AudioBackend.hpp"
 
 using std::vector, std::pair, std::make_pair;
 
@@ -32,16 +38,24 @@ public:
 	void ProcessInput();
 
 	/**
-	 * @brief Updates the ship's state.
+	 * @brief Moves the ship and its bullets.
 	 * @param deltaTime Time elapsed since the last update.
 	 */
 	void Update( float deltaTime );
 
 	/**
-	 * @brief Renders the ship on the given renderer.
-	 * @param renderer SDL Renderer to draw the ship.
+	 * @brief Renders the ship and its bullets from a render snapshot.
+	 * Only reads the snapshot, so it can run while the ship is being updated.
+	 * The ship's wire frame goes to the game's line batch, drawn when the batch is flushed.
+	 * @param snapshot The snapshot to draw.
 	 */
-	void Render( SDL_Renderer* renderer );
+	static void Render( const RenderSnapshot& snapshot );
+
+	/**
+	 * @brief Copies what the renderer needs to draw the ship and its bullets into a snapshot.
+	 * @param snapshot The snapshot to fill.
+	 */
+	void WriteRenderSnapshot( RenderSnapshot& snapshot ) const;
 
 	/**
 	* @brief Performs cleanup of the ship's resources.
@@ -63,6 +77,17 @@ public:
 	 */
 	SpaceObject& GetSpaceObject() { return mShip; }
 
+	/**
+	 * @brief Retrieves the ship's model coordinates (shared by every ship, never changes).
+	 * @return The ship's wire frame vertices (before being transformed).
+	 */
+	static const std::vector<std::pair<float, float>>& GetModel();
+
+	/**
+	 * @brief Returns the paths of the ship's sound effects (hover, laser, death, asteroid hit), e.g. to preload them.
+	 */
+	static std::vector<std::string> GetSoundPaths();
+
 	/**
 	 * @brief Checks if the ship is dead.
 	 * @return True if the ship is dead, false otherwise.
@@ -85,18 +110,11 @@ public:
 	void MoveShip( float deltaTime );
 
 	/**
-	* @brief Moves a bullet, updating its position.
-	* @param bullet The bullet to move.
-	* @param deltaTime Time since last update.
-	*/
-	void MoveBullet( SpaceObject& bullet, float deltaTime );
-
-	/**
-	* @brief Checks collision of the ship with an asteroid.
-	* @param asteroid Pointer to the asteroid to check collision with.
+	* @brief Checks collision of the ship with the asteroids.
+	* @param asteroids The asteroids broadphase grid to check collision with.
 	* @return True if there is a collision, false otherwise.
 	*/
-	bool IsCollidingWithAsteroid( Asteroid* asteroid );
+	bool IsCollidingWithAsteroid( const Broadphase& asteroids ) const;
 
 	/**
 	 * @brief Halts all playing sounds related to the ship.
@@ -110,15 +128,60 @@ public:
 	void LoadAndSetSFX();
 
 	/**
-	 * @brief Checks for collisions between the ship's bullets and asteroids.
+	 * @brief Checks for collisions between the ship and the asteroids, kills the ship on collision.
+	 * @param asteroids The asteroids broadphase grid.
 	 */
-	void CheckAsteroidsCollision();
-	
+	void CheckAsteroidsCollision( const Broadphase& asteroids );
+
+	/**
+	* @brief Finds which asteroid (if any) each bullet in [begin, end) hits.
+	* Only reads the asteroids, so ranges of bullets can be checked in parallel.
+	* @param asteroids The asteroids broadphase grid.
+	* @param begin The first bullet index.
+	* @param end One past the last bullet index.
+	* @return The number of bullet/asteroid pairs tested.
+	*/
+	int FindBulletHits( const Broadphase& asteroids, std::size_t begin, std::size_t end );
+
 	/**
 	* @brief Updates the state of bullets fired by the ship.
-	* @param deltaTime Time since the last update.
+	* Applies the hits found by FindBulletHits: splits the hit asteroids and removes their bullets.
 	*/
-	void UpdateBullets( float deltaTime );
+	void UpdateBullets();
+
+	/**
+	 * @brief Adds a bullet in flight (SpawnBullet fires one from the ship's nose).
+	 * @param bullet The bullet's position, velocity and size.
+	 */
+	void AddBullet( const SpaceObject& bullet );
+
+	/**
+	 * @brief Brings the ship back to life at a position, without its bullets (their storage is kept).
+	 */
+	void Reset( const glm::vec2& position );
+
+	/**
+	 * @brief Returns the number of bullets in flight.
+	 */
+	std::size_t GetBulletCount() const { return mBullets.Size(); }
+
+	/// Setters
+	///--------------------------------------------------------
+
+	/**
+	 * @brief Makes the ship turn on its own and ignore the keyboard.
+	 */
+	void SetAutopilot( bool autopilot ) { mAutopilot = autopilot; }
+
+	/**
+	 * @brief Sets how many bullets per second the ship fires on its own, 0 leaves firing to the player.
+	 */
+	void SetFireRate( float bulletsPerSecond ) { mFireRate = bulletsPerSecond; }
+
+	/**
+	 * @brief Makes the ship survive asteroid hits.
+	 */
+	void SetInvincible( bool invincible ) { mInvincible = invincible; }
 
 private:
 	/**
@@ -132,12 +195,11 @@ private:
 
 	/**
 	 * @brief Spawns a bullet at the ship's position.
+	 * @param age How long ago the bullet was fired, in seconds (it starts that far along its path).
 	 */
-	void SpawnBullet();
+	void SpawnBullet( float age = 0.f );
 
 private:
-	// Model coordinates for the ship.
-	std::vector<std::pair<float, float>> vecModelShip;
 	// SpaceObject representing the ship.
 	SpaceObject mShip;
 	// Color of the ship.
@@ -151,32 +213,37 @@ private:
 	// Speed of rotation.
 	static const float mRotationSpeed;
 
-	// Vector of bullets fired by the ship.
-	std::vector<SpaceObject> mBulletsVec;
+	// Packed bullets fired by the ship, moved by the kinematics kernel.
+	KinematicsBatch mBullets;
+	// Index (in the asteroids broadphase) of the asteroid each bullet hit, -1 for none.
+	std::vector<int> mBulletHits;
 	// Speed of bullets.
 	float mBulletSpeed;
 
-	// Sound chunk for the hover sound.
-	Mix_Chunk* mHoverSound;
-	// Channel for the hover sound.
-	int mHoverChannel;
+	// Handle of the hover sound.
+	venture::SoundHandle mHoverSound = venture::INVALID_SOUND;
 
-	// Sound chunk for the laser sound.
-	Mix_Chunk* mLaserSound;
-	// Channel for the laser sound.
-	int mLaserChannel;
+	// Handle of the laser sound.
+	venture::SoundHandle mLaserSound = venture::INVALID_SOUND;
 
-	// Sound chunk for the death sound.
-	Mix_Chunk* mDeadSound;
-	// Channel for the death sound.
-	int mDeadChannel;
+	// Handle of the death sound.
+	venture::SoundHandle mDeadSound = venture::INVALID_SOUND;
 
-	// Sound chunk for the asteroid hit sound.
-	Mix_Chunk* mAsteroidHitSound;
-	// Channel for the asteroid hit sound.
-	int mAsteroidHitChannel;
+	// Handle of the asteroid hit sound.
+	venture::SoundHandle mAsteroidHitSound = venture::INVALID_SOUND;
 
 	// Offset from the center of the ship to its top point.
 	static const float topPointOffset;
+	// Distance past the screen edges at which bullets are removed.
+	static const float BULLET_MARGIN;
+
+	// Whether the ship flies on its own (see Scenario).
+	bool mAutopilot = false;
+	// Whether asteroids can't kill the ship.
+	bool mInvincible = false;
+	// Bullets fired per second without input.
+	float mFireRate = 0.f;
+	// Seconds until the next automatic bullet.
+	float mFireCooldown = 0.f;
 
 };
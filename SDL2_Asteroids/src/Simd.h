@@ -0,0 +1,16 @@
+#pragma once
+
+// Detects which SIMD instruction sets the compiler targets, and includes their intrinsics.
+// ASTEROIDS_HAS_SSE2 is set on every x64 build, ASTEROIDS_HAS_AVX2 only when AVX2 and FMA code
+// generation are both enabled (/arch:AVX2, or -mavx2 -mfma): the AVX2 paths use fused multiply adds.
+// MSVC doesn't define __FMA__, /arch:AVX2 implies it.
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define ASTEROIDS_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined( __AVX2__ ) && ( defined( __FMA__ ) || defined( _MSC_VER ) )
+#define ASTEROIDS_HAS_AVX2 1
+#include <immintrin.h>
+#endif
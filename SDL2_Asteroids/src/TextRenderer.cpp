@@ -7,15 +7,14 @@ namespace venture
 		: mText( text ), mTextSize( textSize ), mTextColor( textColor )
 	{
 		mPosition = glm::vec2();
-		std::string defaultFont = std::string( SOLUTION_DIR ) + "Assets/fonts/pixeldue.ttf";
+		mSize = glm::ivec2();
+		mFontPath = FontManager::GetDefaultFontPath();
 
-		mFont.reset( TTF_OpenFont( defaultFont.c_str(), mTextSize ) );
+		mFont = FontManager::get()->GetFont( mFontPath, mTextSize );
 		if ( mFont == nullptr )
 		{
 			printf( "Failed to open font!" );
 		}
-
-		mTexture.reset( new Texture() );
 	}
 
 	TextRenderer::~TextRenderer()
@@ -28,26 +27,90 @@ namespace venture
 
 	void TextRenderer::CreateText()
 	{
-		if ( !mTexture->CreateTextureFromText(
-			Game::GetInstance()->GetRenderer(),
-			mFont.get(),
-			mText,
-			mTextColor ) )
+		if ( mGlyphAtlas == nullptr )
 		{
-			printf( "Failed to create a texture from text!\n" );
+			SDL_Renderer* renderer = Game::GetInstance()->GetRenderer();
+			if ( !mFontPath.empty() )
+			{
+				mGlyphAtlas = FontManager::get()->GetGlyphAtlas( renderer, mFontPath, mTextSize );
+			}
+			else if ( mFont != nullptr )
+			{
+				// Custom fonts get their own atlas
+				auto atlas = std::make_shared<GlyphAtlas>();
+				if ( atlas->Create( renderer, mFont.get() ) )
+				{
+					mGlyphAtlas = std::move( atlas );
+				}
+			}
+
+			if ( mGlyphAtlas == nullptr )
+			{
+				printf( "Failed to create the glyph atlas!\n" );
+				return;
+			}
 		}
+
+		LayoutText();
 	}
 
-	void venture::TextRenderer::RenderText( SDL_Renderer* renderer, const glm::vec2& position )
+	void TextRenderer::RenderText( SDL_Renderer* renderer, const glm::vec2& position )
 	{
-		SDL_SetRenderDrawColor( renderer, mTextColor.r, mTextColor.g, mTextColor.b, mTextColor.a );
-		if(mTexture)
-			mTexture->Render( renderer, static_cast< int >( position.x ), static_cast< int >( position.y ) );
+		if ( mIndices.empty() )
+		{
+			return;
+		}
+
+		// Moving the text only offsets the quads already laid out
+		if ( position != mPosition )
+		{
+			glm::vec2 offset = position - mPosition;
+			for ( SDL_Vertex& vertex : mVertices )
+			{
+				vertex.position.x += offset.x;
+				vertex.position.y += offset.y;
+			}
+			mPosition = position;
+		}
+
+		SDL_RenderGeometry( renderer, mGlyphAtlas->GetTexture(), mVertices.data(), static_cast< int >( mVertices.size() ),
+							mIndices.data(), static_cast< int >( mIndices.size() ) );
 	}
 
 	void TextRenderer::UpdateText( const std::string& newText )
 	{
+		if ( newText == mText )
+		{
+			return;
+		}
+
 		mText = newText;
-		CreateText(); // Recreate the texture with new text
+		LayoutText();
+	}
+
+	void TextRenderer::SetFont( std::unique_ptr<TTF_Font, SDLFontDeleter> newFont )
+	{
+		mFont.reset( newFont.release(), SDLFontDeleter() );
+		mFontPath.clear();
+		mGlyphAtlas.reset();
+	}
+
+	void TextRenderer::SetTextSize( int newSize )
+	{
+		mTextSize = newSize;
+		mFontPath = FontManager::GetDefaultFontPath();
+		mFont = FontManager::get()->GetFont( mFontPath, mTextSize );
+		mGlyphAtlas.reset();
+	}
+
+	void TextRenderer::LayoutText()
+	{
+		mVertices.clear();
+		mIndices.clear();
+		if ( mGlyphAtlas == nullptr )
+		{
+			return;
+		}
+		mSize = mGlyphAtlas->LayoutText( mText, mPosition.x, mPosition.y, mTextColor, mVertices, mIndices );
 	}
-}
\ No newline at end of file
+}
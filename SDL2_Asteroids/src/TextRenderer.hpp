@@ -1,10 +1,13 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <vector>
 #include <glm/glm.hpp>
 #include <SDL2/SDL_ttf.h>
 
 #include "Texture.hpp"
+#include "GlyphAtlas.hpp"
+#include "FontManager.hpp"
 #include "Timer.h"
 
 namespace venture
@@ -14,6 +17,9 @@ namespace venture
 	// NOTE: if you want to use the setters such as "SetFont"/"SetTextColor"/"SetTextSize" 
 	// You MUST call them before you call "CreateText" as the text attributes cannot be changed at runtime.
 	// I.E Setting the font to a custom one / changing the color, must happen before we create the text.
+	// The text is drawn from the font's glyph atlas, one quad per character, and is only laid out
+	// again when UpdateText() is given a different string. Fonts and atlases come from the FontManager,
+	// so constructing a TextRenderer doesn't open or rasterize anything that is already cached.
 
 	/**
 	 * @brief A custom deleter for the Texture class.
@@ -58,18 +64,18 @@ namespace venture
 		void Clean();
 
 		/**
-		 * @brief Creates the text to render 
+		 * @brief Rasterizes the font's glyph atlas (once) and lays out the text
 		 */
 		void CreateText();
 		
 		/**
-		 * @brief Renders the text at a certain position
+		 * @brief Renders the text at a certain position (a single draw call)
 		 * @param position The position of the text to render
 		 */
 		void RenderText( SDL_Renderer* renderer, const glm::vec2& position );
 
 		/**
-		 * @brief Recreates the text texture
+		 * @brief Changes the text, the quads are only laid out again if the text is different
 		 * @param newText The new text to render 
 		 */
 		void UpdateText( const std::string& newText );
@@ -79,10 +85,10 @@ namespace venture
 		///--------------------------------------------------------
 		
 		/**
-		 * @brief Set a custom font
+		 * @brief Set a custom font (not shared through the FontManager)
 		 * @param newFont The new font to set for the text
 		 */
-		void SetFont( std::unique_ptr<TTF_Font, SDLFontDeleter> newFont ) { mFont = std::move( newFont ); }
+		void SetFont( std::unique_ptr<TTF_Font, SDLFontDeleter> newFont );
 		
 		/**
 		 * @brief Set the text color
@@ -91,10 +97,10 @@ namespace venture
 		void SetTextColor( SDL_Color newColor ) { mTextColor = newColor; }
 		
 		/**
-		 * @brief Set the text size
+		 * @brief Set the text size (switches to the default font at that size)
 		 * @param newSize The new size for the text
 		 */
-		void SetTextSize( int newSize ) { mTextSize = newSize; }
+		void SetTextSize( int newSize );
 
 		/// Getters 
 		///--------------------------------------------------------
@@ -102,22 +108,22 @@ namespace venture
 		/**
 		 * @brief Get the text font
 		 */
-		std::unique_ptr<TTF_Font, SDLFontDeleter>& GetFont() { return mFont; }
+		TTF_Font* GetFont() const { return mFont.get(); }
 		
 		/**
-		 * @brief Get the text texture
+		 * @brief Get the glyph atlas the text is drawn from
 		 */
-		std::unique_ptr<Texture, TextureDeleter>& GetTextTexture() { return mTexture; }
+		const std::shared_ptr<GlyphAtlas>& GetGlyphAtlas() const { return mGlyphAtlas; }
 		
 		/**
 		 * @brief Get the text size
 		 */
-		const glm::ivec2 GetTextSize() const { return mTexture->GetTextureSize(); }
+		const glm::ivec2 GetTextSize() const { return mSize; }
 		
 		/**
-		 * @brief Get the text position
+		 * @brief Get the position the text was last rendered at
 		 */
-		glm::vec2& GetTextPosition() { return mPosition; }
+		const glm::vec2& GetTextPosition() const { return mPosition; }
 
 		/**
 		 * @brief Get the text color
@@ -126,10 +132,23 @@ namespace venture
 
 		
 	private:
-		// The font of the text
-		std::unique_ptr<TTF_Font, SDLFontDeleter> mFont;
-		// The texture of the text
-		std::unique_ptr<Texture, TextureDeleter> mTexture;
+		/**
+		 * @brief Lays the text out as quads at mPosition
+		 */
+		void LayoutText();
+
+	private:
+		// The font of the text (shared with the other renderers using the same file and size)
+		std::shared_ptr<TTF_Font> mFont;
+		// The font file, empty for a custom font
+		std::string mFontPath;
+		// The font's glyphs, rasterized once per font
+		std::shared_ptr<GlyphAtlas> mGlyphAtlas;
+		// One quad per character, laid out at mPosition
+		std::vector<SDL_Vertex> mVertices;
+		std::vector<int> mIndices;
+		// The size of the laid out text
+		glm::ivec2 mSize;
 		// The text to render
 		std::string mText;
 		// The text color
@@ -1,4 +1,5 @@
 #include "Texture.hpp"
+#include "AssetCache.hpp"
 #include <cstdio>
 
 namespace venture
@@ -12,7 +13,8 @@ namespace venture
 
 	Texture::Texture( Texture&& other ) noexcept
 
-		: mSize( other.mSize ), mTexture( std::move( other.mTexture ) )
+		: mTexture( std::move( other.mTexture ) ), mSize( other.mSize )
+		, mColorMod( other.mColorMod ), mBlendMode( other.mBlendMode ), mModulated( other.mModulated )
 	{
 		other.SetTextureSize( glm::ivec2( 0, 0 ) );
 	}
@@ -21,29 +23,14 @@ namespace venture
 
 	bool Texture::CreateTexture( SDL_Renderer* renderer, std::string path )
 	{
-
-		SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-		if ( loadedSurface == nullptr )
-		{
-			printf( "Unable to load image %s! Error: %s\n", path.c_str(), IMG_GetError() );
-			return false;
-		}
-
-
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0, 0 ) );
-
-		SDL_Texture* newTexture = SDL_CreateTextureFromSurface( renderer, loadedSurface );
-		if ( newTexture == nullptr )
+		mTexture = AssetCache::get()->LoadTexture( renderer, path );
+		if ( mTexture == nullptr )
 		{
-			printf( "Failed to create texture from %s! Error: %s", path.c_str(), SDL_GetError() );
 			return false;
 		}
-		SDL_FreeSurface( loadedSurface );
-
-		SDL_QueryTexture( newTexture, nullptr, nullptr, &mSize.x, &mSize.y );
 
-		mTexture.reset( newTexture );
-		return ( mTexture != nullptr );
+		SDL_QueryTexture( mTexture.get(), nullptr, nullptr, &mSize.x, &mSize.y );
+		return true;
 	}
 
 	bool Texture::CreateTextureFromText( SDL_Renderer* renderer, TTF_Font* font, std::string textureText, SDL_Color textColor )
@@ -56,7 +43,7 @@ namespace venture
 			return false;
 		}
 
-		mTexture.reset( SDL_CreateTextureFromSurface( renderer, loadedSurface ) );
+		mTexture.reset( SDL_CreateTextureFromSurface( renderer, loadedSurface ), SDLTextureDeleter() );
 		if ( mTexture == nullptr )
 		{
 			printf( "Failed to create texture from text %s! Error: %s", textureText.c_str(), SDL_GetError() );
@@ -74,7 +61,7 @@ namespace venture
 	{
 		SDL_Rect srcRect = { 0, 0, mSize.x, mSize.y };
 		SDL_Rect renderQuad = { xPos, yPos, mSize.x, mSize.y };
-		SDL_RenderCopyEx( renderer, mTexture.get(), &srcRect, &renderQuad, 0.0, nullptr, SDL_FLIP_NONE );
+		RenderCopy( renderer, &srcRect, &renderQuad, SDL_FLIP_NONE );
 	}
 
 	void Texture::RenderFrame( SDL_Renderer* renderer, int xPos, int yPos, SDL_Rect* clip, SDL_RendererFlip flip )
@@ -90,7 +77,7 @@ namespace venture
 		}
 
 		//Render to screen
-		SDL_RenderCopyEx( renderer, mTexture.get(), clip, &renderQuad, 0.0, nullptr, flip );
+		RenderCopy( renderer, clip, &renderQuad, flip );
 
 	}
 
@@ -101,15 +88,50 @@ namespace venture
 
 	void Texture::SetBlendMode( SDL_BlendMode blending )
 	{
-		SDL_SetTextureBlendMode( mTexture.get(), blending );
+		mBlendMode = blending;
+		mModulated = true;
 	}
 
 	void Texture::setAlpha( Uint8 alpha )
 	{
-		SDL_SetTextureAlphaMod( mTexture.get(), alpha );
+		mColorMod.a = alpha;
+		mModulated = true;
 	}
 	void Texture::SetTextureColor( SDL_Color newColor )
 	{
-		SDL_SetTextureColorMod( mTexture.get(), newColor.r, newColor.g, newColor.b );
+		mColorMod.r = newColor.r;
+		mColorMod.g = newColor.g;
+		mColorMod.b = newColor.b;
+		mModulated = true;
+	}
+
+	void Texture::RenderCopy( SDL_Renderer* renderer, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip )
+	{
+		SDL_Texture* texture = mTexture.get();
+		if ( !mModulated )
+		{
+			SDL_RenderCopyEx( renderer, texture, srcRect, dstRect, 0.0, nullptr, flip );
+			return;
+		}
+
+		// The other users of a cached texture keep their own modulation
+		SDL_Color savedColor;
+		SDL_BlendMode savedBlendMode;
+		SDL_GetTextureColorMod( texture, &savedColor.r, &savedColor.g, &savedColor.b );
+		SDL_GetTextureAlphaMod( texture, &savedColor.a );
+		SDL_GetTextureBlendMode( texture, &savedBlendMode );
+
+		SDL_SetTextureColorMod( texture, mColorMod.r, mColorMod.g, mColorMod.b );
+		SDL_SetTextureAlphaMod( texture, mColorMod.a );
+		if ( mBlendMode != SDL_BLENDMODE_INVALID )
+		{
+			SDL_SetTextureBlendMode( texture, mBlendMode );
+		}
+
+		SDL_RenderCopyEx( renderer, texture, srcRect, dstRect, 0.0, nullptr, flip );
+
+		SDL_SetTextureColorMod( texture, savedColor.r, savedColor.g, savedColor.b );
+		SDL_SetTextureAlphaMod( texture, savedColor.a );
+		SDL_SetTextureBlendMode( texture, savedBlendMode );
 	}
 }
\ No newline at end of file
@@ -40,7 +40,7 @@ namespace venture
 		~Texture();
 
 		/**
-		 * @brief Creates a texture from an image file.
+		 * @brief Creates a texture from an image file (loaded once, through the AssetCache).
 		 * @param renderer The SDL renderer.
 		 * @param path The path to the image file.
 		 * @return true on success, false on failure.
@@ -91,6 +91,12 @@ namespace venture
 		 */
 		void SetTextureSize( const glm::ivec2& newSize ) { mSize = newSize; }
 
+		/// Modulation
+		///--------------------------------------------------------
+
+		// Image textures share their SDL_Texture through the AssetCache, so the blend mode, alpha and color
+		// are kept per instance and only applied around this instance's render calls.
+
 		/**
 		 * @brief Sets the blending mode of the texture.
 		 * @param blending The SDL_BlendMode to use for the texture.
@@ -110,10 +116,21 @@ namespace venture
 		void SetTextureColor( SDL_Color newColor );
 
 	private:
-		// Managed pointer to the SDL_Texture.
-		std::unique_ptr<SDL_Texture, SDLTextureDeleter> mTexture;
+		/**
+		 * @brief Draws the texture with this instance's modulation, and restores the shared texture's afterwards.
+		 */
+		void RenderCopy( SDL_Renderer* renderer, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip );
+
+		// Managed pointer to the SDL_Texture (shared with the AssetCache for image textures).
+		std::shared_ptr<SDL_Texture> mTexture;
 		// Size (width and height) of the texture.
 		glm::ivec2 mSize;
+		// This instance's color and alpha modulation
+		SDL_Color mColorMod = { 255, 255, 255, 255 };
+		// This instance's blend mode, SDL_BLENDMODE_INVALID keeps the texture's own
+		SDL_BlendMode mBlendMode = SDL_BLENDMODE_INVALID;
+		// Whether any modulation was set (the render calls skip the save and restore otherwise)
+		bool mModulated = false;
 	};
 
 	/**
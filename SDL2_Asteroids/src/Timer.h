@@ -1,22 +1,21 @@
 // The Timer class allows you to create and manage timers with precise control over
 // starting, stopping, pausing, resuming, and checking the elapsed time. It is designed
-// for single-threaded applications and can be used to execute a callback function when
-// a timer interval elapses.
+// for single-threaded applications.
 //
 // Features:
 // - Start, stop, pause, and resume timers.
 // - Retrieve the elapsed time in seconds and milliseconds.
-// - Set a timer to execute a callback function after a specified interval.
 //
 // Example Usage:
 //
 // @code
-// venture::Timer myTimer; <--Initialization
-// myTimer.SetTimer(5, []() { <--Setting a timer for 5 seconds than the lambda gets called.
-//     std::cout << "Timer callback called!" << std::endl;
-// });
+// Timer myTimer; <--Initialization
+// myTimer.Start();
+// float seconds = myTimer.Peek();
 // @endcode
 //
+// To run a callback after a delay, schedule it on a venture::TimerWheel (see Game::GetTimerWheel).
+//
 // @note It is common to use this class within an application loop for tasks like handling
 // user input, updating game logic, and rendering, allowing precise control over timed events.
 // This class is intended for use in single-threaded applications.
@@ -24,17 +23,13 @@
 
 #include <chrono>
 #include <cstdint>
-#include <functional>
-#include <thread>
 
 /**
- * @brief A Simple, Versatile <chrono> based Timer utility class for managing time intervals and callbacks.
+ * @brief A Simple, Versatile <chrono> based Timer utility class for measuring time intervals.
  */
 class Timer {
 
     using SteadyTimePoint = std::chrono::time_point<std::chrono::steady_clock>;
-    using TimerCallback = std::function<void(void)>;
-    using Interval = std::chrono::seconds;
 
 public:
     /**
@@ -165,26 +160,6 @@ public:
         return false;
     }
 
-    /**
-     * @brief Sets a timer to count down for a specified number of seconds and calls a callback function when it ends.
-     * @param seconds The number of seconds for the timer.
-     * @param callback The function to call when the timer ends.
-     */
-    void SetTimer(int seconds, const TimerCallback& callback)
-    {
-        Interval interval(seconds);
-        // Create a new thread to run the timer
-        std::thread timerThread([=]() {
-            Start(); // Start the timer
-            std::this_thread::sleep_for(interval); // Sleep for the specified interval
-            callback(); // Call the callback function
-            Stop(); // Stop the timer
-        });
-
-        // Detach the thread, so it runs independently
-        timerThread.detach();
-    }
-
 private:
     /**
      * @brief Start the timer at a specified time point.
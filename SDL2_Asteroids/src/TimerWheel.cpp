@@ -0,0 +1,265 @@
+#include "TimerWheel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace venture
+{
+	namespace
+	{
+		TimerHandle MakeHandle( uint32_t index, uint32_t generation )
+		{
+			return ( static_cast< TimerHandle >( generation ) << 32 ) | index;
+		}
+
+		// Index of a tick's slot in a level
+		uint32_t SlotIndex( uint64_t tick, int level )
+		{
+			return static_cast< uint32_t >( tick >> ( level * TimerWheel::SLOT_BITS ) ) & ( TimerWheel::SLOT_COUNT - 1 );
+		}
+	}
+
+	TimerWheel::TimerWheel()
+	{
+		mSlots.fill( static_cast< uint32_t >( NIL ) );
+	}
+
+	TimerHandle TimerWheel::Schedule( uint64_t delay, TimerCallback callback, uint64_t interval )
+	{
+		uint32_t index = mFreeList;
+		if ( index != NIL )
+		{
+			mFreeList = mNodes[ index ].mNext;
+		}
+		else
+		{
+			index = static_cast< uint32_t >( mNodes.size() );
+			mNodes.emplace_back();
+		}
+
+		Node& node = mNodes[ index ];
+		node.mDeadline = mCurrentTick + std::max<uint64_t>( delay, 1 );
+		node.mInterval = interval;
+		node.mCallback = std::move( callback );
+		node.mActive = true;
+		Link( index );
+		++mPendingCount;
+		return MakeHandle( index, node.mGeneration );
+	}
+
+	bool TimerWheel::Cancel( TimerHandle timer )
+	{
+		Node* node = Find( timer );
+		if ( node == nullptr )
+		{
+			return false;
+		}
+
+		uint32_t index = static_cast< uint32_t >( node - mNodes.data() );
+		if ( node->mSlot != NIL )
+		{
+			Unlink( index );
+		}
+		Release( index );
+		return true;
+	}
+
+	bool TimerWheel::IsPending( TimerHandle timer ) const
+	{
+		return Find( timer ) != nullptr;
+	}
+
+	void TimerWheel::AdvanceTo( uint64_t tick )
+	{
+		mTargetTick = tick;
+		while ( mCurrentTick < mTargetTick )
+		{
+			// Nothing can fire before the lowest occupied level cascades, skip the empty ticks
+			int lowestLevel = 0;
+			while ( lowestLevel < LEVEL_COUNT && mLevelCounts[ lowestLevel ] == 0 )
+			{
+				++lowestLevel;
+			}
+			if ( lowestLevel == LEVEL_COUNT )
+			{
+				mCurrentTick = mTargetTick;
+				break;
+			}
+			if ( lowestLevel > 0 )
+			{
+				uint64_t nextCascade = ( ( mCurrentTick >> ( lowestLevel * SLOT_BITS ) ) + 1 ) << ( lowestLevel * SLOT_BITS );
+				mCurrentTick = std::min( nextCascade, mTargetTick + 1 ) - 1;
+				if ( mCurrentTick == mTargetTick )
+				{
+					break;
+				}
+			}
+
+			++mCurrentTick;
+
+			// The lowest level wrapped around: its next SLOT_COUNT ticks come down from the level above,
+			// which may have wrapped around too (the highest level cascades first)
+			int topLevel = 0;
+			while ( topLevel + 1 < LEVEL_COUNT && SlotIndex( mCurrentTick, topLevel ) == 0 )
+			{
+				++topLevel;
+			}
+			for ( int level = topLevel; level > 0; --level )
+			{
+				Cascade( level );
+			}
+
+			FireCurrentSlot();
+		}
+	}
+
+	void TimerWheel::Clear()
+	{
+		for ( uint32_t index = 0; index < mNodes.size(); ++index )
+		{
+			if ( mNodes[ index ].mActive )
+			{
+				if ( mNodes[ index ].mSlot != NIL )
+				{
+					Unlink( index );
+				}
+				Release( index );
+			}
+		}
+		mCurrentTick = 0;
+		mTargetTick = 0;
+	}
+
+	TimerWheel::Node* TimerWheel::Find( TimerHandle timer )
+	{
+		return const_cast< Node* >( static_cast< const TimerWheel* >( this )->Find( timer ) );
+	}
+
+	const TimerWheel::Node* TimerWheel::Find( TimerHandle timer ) const
+	{
+		uint32_t index = static_cast< uint32_t >( timer );
+		uint32_t generation = static_cast< uint32_t >( timer >> 32 );
+		if ( index >= mNodes.size() || !mNodes[ index ].mActive || mNodes[ index ].mGeneration != generation )
+		{
+			return nullptr;
+		}
+		return &mNodes[ index ];
+	}
+
+	void TimerWheel::Link( uint32_t index )
+	{
+		Node& node = mNodes[ index ];
+
+		// The lowest level whose slot holding the deadline is still ahead: the deadline and the current tick
+		// share everything above that level's slot index
+		int level = 0;
+		while ( level < LEVEL_COUNT && ( node.mDeadline >> ( ( level + 1 ) * SLOT_BITS ) ) != ( mCurrentTick >> ( ( level + 1 ) * SLOT_BITS ) ) )
+		{
+			++level;
+		}
+
+		uint32_t slot = 0;
+		if ( level < LEVEL_COUNT )
+		{
+			slot = level * SLOT_COUNT + SlotIndex( node.mDeadline, level );
+		}
+		else
+		{
+			// Past the wheel's span: parked in the last level's next slot, which cascades it back in before it's due
+			level = LEVEL_COUNT - 1;
+			slot = level * SLOT_COUNT + ( ( SlotIndex( mCurrentTick, level ) + 1 ) & ( SLOT_COUNT - 1 ) );
+		}
+
+		++mLevelCounts[ level ];
+		node.mSlot = slot;
+		node.mPrev = NIL;
+		node.mNext = mSlots[ slot ];
+		if ( node.mNext != NIL )
+		{
+			mNodes[ node.mNext ].mPrev = index;
+		}
+		mSlots[ slot ] = index;
+	}
+
+	void TimerWheel::Unlink( uint32_t index )
+	{
+		Node& node = mNodes[ index ];
+		if ( node.mPrev != NIL )
+		{
+			mNodes[ node.mPrev ].mNext = node.mNext;
+		}
+		else
+		{
+			mSlots[ node.mSlot ] = node.mNext;
+		}
+		if ( node.mNext != NIL )
+		{
+			mNodes[ node.mNext ].mPrev = node.mPrev;
+		}
+		--mLevelCounts[ node.mSlot / SLOT_COUNT ];
+		node.mPrev = NIL;
+		node.mNext = NIL;
+		node.mSlot = NIL;
+	}
+
+	void TimerWheel::Release( uint32_t index )
+	{
+		Node& node = mNodes[ index ];
+		node.mCallback = nullptr;
+		node.mActive = false;
+		++node.mGeneration;
+		node.mNext = mFreeList;
+		mFreeList = index;
+		--mPendingCount;
+	}
+
+	void TimerWheel::Cascade( int level )
+	{
+		uint32_t slot = level * SLOT_COUNT + SlotIndex( mCurrentTick, level );
+		uint32_t index = mSlots[ slot ];
+		mSlots[ slot ] = NIL;
+		while ( index != NIL )
+		{
+			uint32_t next = mNodes[ index ].mNext;
+			--mLevelCounts[ level ];
+			Link( index );
+			index = next;
+		}
+	}
+
+	void TimerWheel::FireCurrentSlot()
+	{
+		uint32_t slot = SlotIndex( mCurrentTick, 0 );
+		while ( mSlots[ slot ] != NIL )
+		{
+			uint32_t index = mSlots[ slot ];
+			Unlink( index );
+
+			// A deadline past the wheel's span was parked early, it goes back in until it's due
+			if ( mNodes[ index ].mDeadline > mCurrentTick )
+			{
+				Link( index );
+				continue;
+			}
+
+			// The callback may schedule timers (growing the pool) or cancel this one, so it runs from a local
+			TimerCallback callback = std::move( mNodes[ index ].mCallback );
+			uint32_t generation = mNodes[ index ].mGeneration;
+			if ( mNodes[ index ].mInterval == 0 )
+			{
+				Release( index );
+				callback();
+				continue;
+			}
+
+			callback();
+			Node& node = mNodes[ index ];
+			if ( node.mActive && node.mGeneration == generation )
+			{
+				node.mCallback = std::move( callback );
+				node.mDeadline = mCurrentTick + node.mInterval;
+				Link( index );
+			}
+		}
+	}
+}
@@ -0,0 +1,164 @@
+/**
+ * @class TimerWheel
+ * @brief A hierarchical timer wheel: thousands of one shot or repeating timers, without any thread.
+ *
+ * Time is counted in ticks (milliseconds of the game's clock). The wheel has LEVEL_COUNT levels of
+ * SLOT_COUNT slots, each level's slot covering SLOT_COUNT times more ticks than the level below; a timer
+ * is linked into the slot its deadline falls in, and when the lowest level wraps around, the next level's
+ * slot is cascaded down. Scheduling and cancelling are O(1) (a pooled node linked or unlinked), advancing
+ * costs one slot per tick plus the occasional cascade, and skips the ticks while the lower levels are empty.
+ *
+ * The callbacks run inside AdvanceTo(), on the thread driving the wheel, in deadline order between ticks.
+ * They may schedule and cancel timers (themselves included).
+ *
+ * Example usage:
+ * @code
+ * venture::TimerWheel timers;
+ * venture::TimerHandle respawn = timers.Schedule( 3000, [&]() { SpawnShip(); } );
+ * timers.Schedule( 30000, [&]() { SpawnWave(); }, 30000 ); // Every 30 seconds
+ * timers.Cancel( respawn );
+ * timers.AdvanceTo( simulatedMilliseconds ); // Once per frame, from the game loop
+ * @endcode
+ *
+ * @note Not thread safe, a wheel must only be used from one thread.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace venture
+{
+	// Refers to a scheduled timer, stays safe to cancel after the timer fired
+	using TimerHandle = uint64_t;
+
+	// A handle that refers to no timer
+	const TimerHandle INVALID_TIMER = 0;
+
+	// The work a timer runs when it fires
+	using TimerCallback = std::function<void()>;
+
+	class TimerWheel
+	{
+	public:
+		// Bits of a tick number each level indexes its slots with
+		static const int SLOT_BITS = 8;
+		// Slots per level
+		static const int SLOT_COUNT = 1 << SLOT_BITS;
+		// Levels of the wheel, together they span 2^32 ticks (later deadlines wait in the last level)
+		static const int LEVEL_COUNT = 4;
+
+		TimerWheel();
+
+		/**
+		 * @brief Schedules a callback.
+		 * @param delay Ticks until the callback runs (at least 1, it runs at the earliest on the next tick).
+		 * @param callback The callback.
+		 * @param interval Ticks between the next runs, 0 runs the callback once.
+		 * @return The timer's handle.
+		 */
+		TimerHandle Schedule( uint64_t delay, TimerCallback callback, uint64_t interval = 0 );
+
+		/**
+		 * @brief Cancels a timer.
+		 * @return True if the timer was pending, false if it already fired (once) or was cancelled.
+		 */
+		bool Cancel( TimerHandle timer );
+
+		/**
+		 * @brief Checks if a timer is still going to fire.
+		 */
+		bool IsPending( TimerHandle timer ) const;
+
+		/**
+		 * @brief Advances the wheel up to a tick, running the callbacks of the timers due on the way.
+		 * @param tick The current time, in ticks (going back in time is ignored).
+		 */
+		void AdvanceTo( uint64_t tick );
+
+		/**
+		 * @brief Cancels every timer and moves the wheel back to tick 0 (for a clock that restarts).
+		 */
+		void Clear();
+
+		/**
+		 * @brief Returns the wheel's current tick.
+		 */
+		uint64_t GetCurrentTick() const { return mCurrentTick; }
+
+		/**
+		 * @brief Returns the number of pending timers.
+		 */
+		std::size_t GetPendingCount() const { return mPendingCount; }
+
+	private:
+		// Marks the end of a slot's list (and of the free list)
+		static const uint32_t NIL = UINT32_MAX;
+
+		// A pooled timer, linked in a slot's list while pending
+		struct Node
+		{
+			// Tick the timer fires at
+			uint64_t mDeadline = 0;
+			// Ticks between two runs, 0 for a one shot timer
+			uint64_t mInterval = 0;
+			TimerCallback mCallback;
+			// Neighbours in the slot's list, or the next free node
+			uint32_t mPrev = NIL;
+			uint32_t mNext = NIL;
+			// The slot (level * SLOT_COUNT + slot) the node is linked in, NIL while firing or free
+			uint32_t mSlot = NIL;
+			// Bumped on every reuse, so the handles of fired and cancelled timers go stale
+			uint32_t mGeneration = 1;
+			bool mActive = false;
+		};
+
+		/**
+		 * @brief Returns the node a handle refers to, or nullptr if the handle is stale.
+		 */
+		Node* Find( TimerHandle timer );
+		const Node* Find( TimerHandle timer ) const;
+
+		/**
+		 * @brief Links a node in the slot its deadline falls in.
+		 */
+		void Link( uint32_t index );
+
+		/**
+		 * @brief Unlinks a node from its slot.
+		 */
+		void Unlink( uint32_t index );
+
+		/**
+		 * @brief Returns a node to the pool.
+		 */
+		void Release( uint32_t index );
+
+		/**
+		 * @brief Moves a slot's timers down to the lower levels.
+		 */
+		void Cascade( int level );
+
+		/**
+		 * @brief Runs the timers of the lowest level's current slot.
+		 */
+		void FireCurrentSlot();
+
+		// The timers, pending and free
+		std::vector<Node> mNodes;
+		// First free node
+		uint32_t mFreeList = NIL;
+		// First node of each slot, level by level
+		std::array<uint32_t, LEVEL_COUNT * SLOT_COUNT> mSlots;
+		// Number of timers linked in each level
+		std::array<std::size_t, LEVEL_COUNT> mLevelCounts{};
+		// The last tick processed
+		uint64_t mCurrentTick = 0;
+		// The tick AdvanceTo is heading to (Clear stops it)
+		uint64_t mTargetTick = 0;
+		// Number of timers scheduled and not fired (once) or cancelled yet
+		std::size_t mPendingCount = 0;
+	};
+}
@@ -0,0 +1,61 @@
+#include "Transform2D.h"
+#include "Simd.h"
+
+#include <cmath>
+
+static_assert( sizeof( std::pair<float, float> ) == 2 * sizeof( float ), "Model vertices must be packed x, y floats" );
+static_assert( sizeof( SDL_FPoint ) == 2 * sizeof( float ), "SDL_FPoint must be packed x, y floats" );
+
+Transform2D Transform2D::FromRotationScaleTranslation( float x, float y, float r, float s )
+{
+	float cosR = cosf( r ) * s;
+	float sinR = sinf( r ) * s;
+	return { cosR, -sinR, x,
+			 sinR, cosR, y };
+}
+
+void Transform2D::Apply( const std::pair<float, float>* modelCoordinates, std::size_t count, SDL_FPoint* outPoints ) const
+{
+	// Both arrays are interleaved x, y floats
+	const float* in = reinterpret_cast< const float* >( modelCoordinates );
+	float* out = reinterpret_cast< float* >( outPoints );
+	std::size_t i = 0;
+
+#if defined( ASTEROIDS_HAS_AVX2 )
+	// 4 points per iteration: out = x * (a c ...) + y * (b d ...) + (tx ty ...)
+	// Multiplies and adds rather than fused multiply adds, so the points round like the SSE2 and scalar ones
+	const __m256 ac = _mm256_setr_ps( mA, mC, mA, mC, mA, mC, mA, mC );
+	const __m256 bd = _mm256_setr_ps( mB, mD, mB, mD, mB, mD, mB, mD );
+	const __m256 t = _mm256_setr_ps( mTx, mTy, mTx, mTy, mTx, mTy, mTx, mTy );
+	for ( ; i + 4 <= count; i += 4 )
+	{
+		__m256 points = _mm256_loadu_ps( in + i * 2 );
+		__m256 xs = _mm256_moveldup_ps( points );
+		__m256 ys = _mm256_movehdup_ps( points );
+		_mm256_storeu_ps( out + i * 2, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( xs, ac ), _mm256_mul_ps( ys, bd ) ), t ) );
+	}
+#endif
+
+#if defined( ASTEROIDS_HAS_SSE2 )
+	// 2 points per iteration
+	const __m128 ac4 = _mm_setr_ps( mA, mC, mA, mC );
+	const __m128 bd4 = _mm_setr_ps( mB, mD, mB, mD );
+	const __m128 t4 = _mm_setr_ps( mTx, mTy, mTx, mTy );
+	for ( ; i + 2 <= count; i += 2 )
+	{
+		__m128 points = _mm_loadu_ps( in + i * 2 );
+		__m128 xs = _mm_shuffle_ps( points, points, _MM_SHUFFLE( 2, 2, 0, 0 ) );
+		__m128 ys = _mm_shuffle_ps( points, points, _MM_SHUFFLE( 3, 3, 1, 1 ) );
+		_mm_storeu_ps( out + i * 2, _mm_add_ps( _mm_add_ps( _mm_mul_ps( xs, ac4 ), _mm_mul_ps( ys, bd4 ) ), t4 ) );
+	}
+#endif
+
+	// Remainder
+	for ( ; i < count; ++i )
+	{
+		float x = in[ i * 2 ];
+		float y = in[ i * 2 + 1 ];
+		out[ i * 2 ] = mA * x + mB * y + mTx;
+		out[ i * 2 + 1 ] = mC * x + mD * y + mTy;
+	}
+}
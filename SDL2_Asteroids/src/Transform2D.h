@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL_rect.h>
+
+// A 2x3 affine matrix, maps a model space point (x, y) to:
+//   x' = mA * x + mB * y + mTx
+//   y' = mC * x + mD * y + mTy
+
+struct Transform2D
+{
+	float mA, mB, mTx;
+	float mC, mD, mTy;
+
+	/**
+	 * @brief Builds the transform that rotates, then scales, then translates.
+	 * The sine and cosine are computed once here, not per vertex.
+	 * @param x The translation's x
+	 * @param y The translation's y
+	 * @param r The rotation (in RAD)
+	 * @param s The scale
+	 */
+	static Transform2D FromRotationScaleTranslation( float x, float y, float r, float s );
+
+	/**
+	 * @brief Transforms a model's vertices in a single (SIMD) pass.
+	 * @param modelCoordinates The model's vertices.
+	 * @param count The number of vertices.
+	 * @param outPoints Receives the transformed vertices, must have room for count points.
+	 */
+	void Apply( const std::pair<float, float>* modelCoordinates, std::size_t count, SDL_FPoint* outPoints ) const;
+};
@@ -0,0 +1,77 @@
+/**
+ * @class TripleBuffer
+ * @brief Lock-free triple buffer to hand data from a single producer thread to a single consumer thread.
+ *
+ * The producer fills the write buffer and publishes it, the consumer reads the latest published buffer.
+ * Neither side ever waits for the other: the third buffer sits in the middle, holding the latest
+ * published data until the consumer picks it up (or the producer publishes a newer one).
+ *
+ * Example usage:
+ * @code
+ * venture::TripleBuffer<Snapshot> buffer;
+ * // Producer thread
+ * buffer.GetWriteBuffer().mValue = 42;
+ * buffer.Publish();
+ * // Consumer thread
+ * const Snapshot& latest = buffer.GetReadBuffer();
+ * @endcode
+ */
+
+#pragma once
+#include <atomic>
+
+namespace venture
+{
+	template<typename T>
+	class TripleBuffer
+	{
+	public:
+
+		/**
+		 * @brief Returns the buffer the producer writes to (only valid until the next Publish).
+		 */
+		T& GetWriteBuffer() { return mBuffers[ mWriteIndex ]; }
+
+		/**
+		 * @brief Publishes the write buffer, the producer gets another buffer to write to.
+		 */
+		void Publish()
+		{
+			int previous = mMiddle.exchange( mWriteIndex | FRESH_BIT, std::memory_order_acq_rel );
+			mWriteIndex = previous & INDEX_MASK;
+		}
+
+		/**
+		 * @brief Returns the latest published buffer (stays valid until the next GetReadBuffer call).
+		 */
+		const T& GetReadBuffer()
+		{
+			if ( HasNewData() )
+			{
+				int previous = mMiddle.exchange( mReadIndex, std::memory_order_acq_rel );
+				mReadIndex = previous & INDEX_MASK;
+			}
+			return mBuffers[ mReadIndex ];
+		}
+
+		/**
+		 * @brief Checks if a buffer was published since the consumer's last GetReadBuffer call.
+		 */
+		bool HasNewData() const { return ( mMiddle.load( std::memory_order_acquire ) & FRESH_BIT ) != 0; }
+
+	private:
+		// Marks the middle buffer as published but not read yet
+		static const int FRESH_BIT = 4;
+		// Extracts the buffer index
+		static const int INDEX_MASK = 3;
+
+		// The three buffers
+		T mBuffers[ 3 ];
+		// Producer's buffer index
+		int mWriteIndex = 0;
+		// Middle buffer index, and the fresh bit
+		std::atomic<int> mMiddle{ 1 };
+		// Consumer's buffer index
+		int mReadIndex = 2;
+	};
+}
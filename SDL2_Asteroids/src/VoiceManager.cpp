@@ -0,0 +1,253 @@
+#include "VoiceManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace venture
+{
+	namespace
+	{
+		// Extra gain per coalesced request, over the sound's own volume
+		const float COALESCE_BOOST = 0.15f;
+		// Distance attenuation of a sound a whole field diagonal away (255 would be silent)
+		const float MAX_DISTANCE = 160.f;
+	}
+
+	void VoiceManager::Init( IAudioBackend* backend, int channelCount )
+	{
+		HaltAll();
+		mBackend = backend;
+		mChannels.assign( mBackend->AllocateChannels( channelCount ), Channel{ INVALID_SOUND, PRIORITY_LOW, false, false, false } );
+	}
+
+	void VoiceManager::Play( SoundHandle sound, int priority )
+	{
+		if ( sound == INVALID_SOUND )
+		{
+			return;
+		}
+
+		for ( Request& request : mRequests )
+		{
+			if ( request.mSound == sound )
+			{
+				request.mPriority = std::max( request.mPriority, priority );
+				++request.mCount;
+				return;
+			}
+		}
+		mRequests.push_back( { sound, priority, 1, 0.f, 0.f, 0 } );
+	}
+
+	void VoiceManager::PlayAt( SoundHandle sound, int priority, float x, float y )
+	{
+		Play( sound, priority );
+		for ( Request& request : mRequests )
+		{
+			if ( request.mSound == sound )
+			{
+				request.mSumX += x;
+				request.mSumY += y;
+				++request.mPositionCount;
+				return;
+			}
+		}
+	}
+
+	void VoiceManager::SetField( float width, float height )
+	{
+		mFieldWidth = width;
+		mFieldHeight = height;
+	}
+
+	void VoiceManager::SetListener( float x, float y )
+	{
+		mListenerX = x;
+		mListenerY = y;
+	}
+
+	void VoiceManager::SetLoop( SoundHandle sound, int priority, bool playing )
+	{
+		if ( sound == INVALID_SOUND )
+		{
+			return;
+		}
+
+		for ( Loop& loop : mLoops )
+		{
+			if ( loop.mSound == sound )
+			{
+				loop.mPriority = priority;
+				loop.mPlaying = playing;
+				return;
+			}
+		}
+		mLoops.push_back( { sound, priority, playing, -1 } );
+	}
+
+	void VoiceManager::Flush()
+	{
+		mMixerCallCount = 0;
+		mDroppedCount = 0;
+		int starts = 0;
+
+		if ( mBackend == nullptr )
+		{
+			mDroppedCount = static_cast< int >( mRequests.size() );
+			mRequests.clear();
+			return;
+		}
+
+		// Loops that stopped (or were stolen) first, so their channels can be reused right away
+		for ( Loop& loop : mLoops )
+		{
+			if ( loop.mChannel < 0 )
+			{
+				continue;
+			}
+
+			bool stolen = mChannels[ loop.mChannel ].mSound != loop.mSound;
+			if ( !loop.mPlaying && !stolen )
+			{
+				mBackend->Halt( loop.mChannel );
+				++mMixerCallCount;
+				mChannels[ loop.mChannel ].mSound = INVALID_SOUND;
+			}
+			if ( !loop.mPlaying || stolen )
+			{
+				loop.mChannel = -1;
+			}
+		}
+
+		// Highest priorities first, the start budget drops the least important sounds
+		std::sort( mRequests.begin(), mRequests.end(), []( const Request& a, const Request& b ) { return a.mPriority > b.mPriority; } );
+
+		mStarts.clear();
+		for ( Loop& loop : mLoops )
+		{
+			if ( !loop.mPlaying || loop.mChannel >= 0 || starts >= MAX_VOICE_STARTS )
+			{
+				continue;
+			}
+
+			int channel = AllocateChannel( loop.mPriority );
+			if ( channel >= 0 )
+			{
+				ReserveVoice( channel, loop.mSound, loop.mPriority, -1, 1.f, true, false, 0.f, 0.f );
+				loop.mChannel = channel;
+				++starts;
+			}
+		}
+
+		for ( const Request& request : mRequests )
+		{
+			int channel = starts < MAX_VOICE_STARTS ? AllocateChannel( request.mPriority ) : -1;
+			if ( channel < 0 )
+			{
+				++mDroppedCount;
+				continue;
+			}
+
+			float gain = 1.f + COALESCE_BOOST * static_cast< float >( request.mCount - 1 );
+			bool positioned = request.mPositionCount > 0;
+			float x = positioned ? request.mSumX / request.mPositionCount : 0.f;
+			float y = positioned ? request.mSumY / request.mPositionCount : 0.f;
+			ReserveVoice( channel, request.mSound, request.mPriority, 0, gain, false, positioned, x, y );
+			++starts;
+		}
+
+		// Pan and attenuate first, so the voices don't start centered
+		Spatialize();
+		for ( const VoiceStart& start : mStarts )
+		{
+			if ( start.mPositioned || mChannels[ start.mChannel ].mPositioned )
+			{
+				mBackend->SetPosition( start.mChannel, start.mLeft, start.mRight, start.mDistance );
+				++mMixerCallCount;
+				mChannels[ start.mChannel ].mPositioned = start.mPositioned;
+			}
+
+			// Playing replaces whatever the channel was playing (stealing it)
+			mBackend->Play( start.mChannel, start.mSound, start.mLoops, start.mGain );
+			++mMixerCallCount;
+			mChannels[ start.mChannel ].mPending = false;
+		}
+
+		mRequests.clear();
+	}
+
+	void VoiceManager::HaltAll()
+	{
+		if ( mBackend != nullptr && !mChannels.empty() )
+		{
+			mBackend->Halt( -1 );
+		}
+		for ( Channel& channel : mChannels )
+		{
+			channel = { INVALID_SOUND, PRIORITY_LOW, false, false, false };
+		}
+		mRequests.clear();
+		mLoops.clear();
+	}
+
+	int VoiceManager::AllocateChannel( int priority )
+	{
+		int lowest = -1;
+		for ( int i = 0; i < static_cast< int >( mChannels.size() ); ++i )
+		{
+			Channel& channel = mChannels[ i ];
+			if ( channel.mPending )
+			{
+				continue;
+			}
+			if ( channel.mSound == INVALID_SOUND || ( !channel.mLooping && !mBackend->IsPlaying( i ) ) )
+			{
+				return i;
+			}
+			if ( channel.mPriority < priority && ( lowest < 0 || channel.mPriority < mChannels[ lowest ].mPriority ) )
+			{
+				lowest = i;
+			}
+		}
+		return lowest;
+	}
+
+	void VoiceManager::ReserveVoice( int channel, SoundHandle sound, int priority, int loops, float gain, bool looping,
+									 bool positioned, float x, float y )
+	{
+		// The channel keeps its positioned flag until the voice is submitted
+		Channel& reserved = mChannels[ channel ];
+		reserved.mSound = sound;
+		reserved.mPriority = priority;
+		reserved.mLooping = looping;
+		reserved.mPending = true;
+
+		// Unpositioned voices reset the channel to centered, full volume
+		mStarts.push_back( { channel, sound, loops, gain, positioned, x, y, 255, 255, 0 } );
+	}
+
+	void VoiceManager::Spatialize()
+	{
+		const float halfWidth = mFieldWidth * 0.5f;
+		const float invDiagonal = 1.f / std::sqrt( mFieldWidth * mFieldWidth + mFieldHeight * mFieldHeight );
+
+		for ( VoiceStart& start : mStarts )
+		{
+			if ( !start.mPositioned )
+			{
+				continue;
+			}
+
+			// Pan: -1 is fully left, 1 fully right, the louder side always stays at full volume
+			float dx = start.mX - mListenerX;
+			float dy = start.mY - mListenerY;
+			float pan = std::clamp( dx / halfWidth, -1.f, 1.f );
+			start.mLeft = static_cast< uint8_t >( 255.f * std::min( 1.f, 1.f - pan ) );
+			start.mRight = static_cast< uint8_t >( 255.f * std::min( 1.f, 1.f + pan ) );
+
+			// Distance: grows with the distance to the listener, relative to the field diagonal
+			float distance = std::min( 1.f, std::sqrt( dx * dx + dy * dy ) * invDiagonal );
+			start.mDistance = static_cast< uint8_t >( distance * MAX_DISTANCE );
+		}
+	}
+}
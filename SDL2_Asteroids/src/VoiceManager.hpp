@@ -0,0 +1,205 @@
+/**
+ * @class VoiceManager
+ * @brief Allocates the mixer channels to the game's sounds, by priority, with a bounded mixer call rate.
+ *
+ * Sounds are requested during the frame and only reach the audio backend when Flush() runs, once per frame:
+ * - The same sound requested several times in a frame plays as a single voice, a bit louder than the sound's own volume.
+ * - Looping sounds are kept playing for as long as they are requested, instead of being retriggered.
+ * - A request takes a free channel, or steals the one playing the lowest priority sound (if lower than its own).
+ * - At most MAX_VOICE_STARTS voices start per flush, the highest priorities first, the rest are dropped.
+ * - Positioned sounds are panned and attenuated from where they happened relative to the listener,
+ *   the pan and gain of every voice started by a flush are computed together, right before submitting them.
+ *
+ * Example usage:
+ * @code
+ * venture::VoiceManager voices;
+ * voices.Init( audioBackend );
+ * voices.PlayAt( hitSound, VoiceManager::PRIORITY_LOW, x, y );    // Any number of times per frame
+ * voices.SetLoop( engineSound, VoiceManager::PRIORITY_NORMAL, thrusting ); // Every frame
+ * voices.SetListener( shipX, shipY );
+ * voices.Flush(); // Once per frame
+ * @endcode
+ *
+ * @note Requests and Flush() must not be called concurrently. The game makes them from the simulation (bullet hits,
+ * the ship's death) and from the main thread while the simulation is idle (Ship::ProcessInput, Game::RestartGame).
+ */
+
+#pragma once
+#include <vector>
+
+#include "AudioBackend.hpp"
+
+namespace venture
+{
+	class VoiceManager
+	{
+	public:
+		// Sound priorities, a higher priority may steal the channel of a lower one
+		static const int PRIORITY_LOW = 0;
+		static const int PRIORITY_NORMAL = 1;
+		static const int PRIORITY_HIGH = 2;
+		static const int PRIORITY_CRITICAL = 3;
+
+		// Maximum number of voices started by a single flush
+		static const int MAX_VOICE_STARTS = 6;
+
+		/// Utility
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Allocates the channels the voices play on.
+		 * @param backend The audio backend the voices play through (must outlive the voice manager's use).
+		 * @param channelCount Number of channels.
+		 */
+		void Init( IAudioBackend* backend, int channelCount = 16 );
+
+		/**
+		 * @brief Requests a one shot sound for this frame.
+		 * @param sound The sound (ignored if invalid).
+		 * @param priority The sound's priority.
+		 */
+		void Play( SoundHandle sound, int priority );
+
+		/**
+		 * @brief Requests a one shot sound that happened at a position, for this frame.
+		 * Coalesced requests play from their average position.
+		 * @param sound The sound (ignored if invalid).
+		 * @param priority The sound's priority.
+		 * @param x The x position the sound happened at.
+		 * @param y The y position the sound happened at.
+		 */
+		void PlayAt( SoundHandle sound, int priority, float x, float y );
+
+		/**
+		 * @brief Sets the size of the play field, positions are panned across its width and attenuated over its diagonal.
+		 */
+		void SetField( float width, float height );
+
+		/**
+		 * @brief Sets where the listener is (e.g. the player), call it before Flush().
+		 */
+		void SetListener( float x, float y );
+
+		/**
+		 * @brief Keeps a looping sound playing (or stops it), call it every frame.
+		 * @param sound The sound (ignored if invalid).
+		 * @param priority The sound's priority.
+		 * @param playing Whether the loop should be playing.
+		 */
+		void SetLoop( SoundHandle sound, int priority, bool playing );
+
+		/**
+		 * @brief Starts and stops the voices requested since the last flush.
+		 */
+		void Flush();
+
+		/**
+		 * @brief Stops every voice and forgets the loops and pending requests.
+		 */
+		void HaltAll();
+
+		/// Getters
+		///--------------------------------------------------------
+
+		/**
+		 * @brief Returns the number of backend calls made by the last flush.
+		 */
+		int GetMixerCallCount() const { return mMixerCallCount; }
+
+		/**
+		 * @brief Returns the number of requests dropped by the last flush (no channel, or over the start budget).
+		 */
+		int GetDroppedCount() const { return mDroppedCount; }
+
+	private:
+		// A one shot sound requested this frame
+		struct Request
+		{
+			SoundHandle mSound;
+			int mPriority;
+			// How many times it was requested this frame
+			int mCount;
+			// Sum of the positions it was requested at, and how many were positioned
+			float mSumX;
+			float mSumY;
+			int mPositionCount;
+		};
+
+		// A looping sound
+		struct Loop
+		{
+			SoundHandle mSound;
+			int mPriority;
+			bool mPlaying;
+			// The channel it plays on, -1 if it isn't playing
+			int mChannel;
+		};
+
+		// What a channel is playing
+		struct Channel
+		{
+			SoundHandle mSound;
+			int mPriority;
+			bool mLooping;
+			// Whether the channel is panned / attenuated
+			bool mPositioned;
+			// Reserved by the current flush, not submitted yet
+			bool mPending;
+		};
+
+		// A voice about to be submitted to the backend
+		struct VoiceStart
+		{
+			int mChannel;
+			SoundHandle mSound;
+			int mLoops;
+			// Scales the sound's own volume
+			float mGain;
+			bool mPositioned;
+			float mX;
+			float mY;
+			// Computed by Spatialize()
+			uint8_t mLeft;
+			uint8_t mRight;
+			uint8_t mDistance;
+		};
+
+		/**
+		 * @brief Finds a channel for a new voice, a free one or the lowest priority one below priority (-1 if none).
+		 */
+		int AllocateChannel( int priority );
+
+		/**
+		 * @brief Reserves a channel for a voice, it starts when the flush submits it.
+		 */
+		void ReserveVoice( int channel, SoundHandle sound, int priority, int loops, float gain, bool looping,
+						   bool positioned, float x, float y );
+
+		/**
+		 * @brief Computes the pan and distance of every positioned voice about to start, in one pass.
+		 */
+		void Spatialize();
+
+	private:
+		// The backend the voices play through
+		IAudioBackend* mBackend = nullptr;
+		// The channels
+		std::vector<Channel> mChannels;
+		// The one shot sounds requested since the last flush (one entry per sound)
+		std::vector<Request> mRequests;
+		// The looping sounds
+		std::vector<Loop> mLoops;
+		// The voices the current flush starts
+		std::vector<VoiceStart> mStarts;
+
+		// The play field size, and the listener position
+		float mFieldWidth = 800.f;
+		float mFieldHeight = 600.f;
+		float mListenerX = 400.f;
+		float mListenerY = 300.f;
+
+		// Statistics of the last flush
+		int mMixerCallCount = 0;
+		int mDroppedCount = 0;
+	};
+}
@@ -0,0 +1,134 @@
+// Packs every file of an assets folder into a single archive (see AssetArchiveFormat.h).
+// Usage: AssetPacker <assets folder> <output archive>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "AssetArchiveFormat.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	// A file to pack
+	struct PackedFile
+	{
+		// Path relative to the assets folder, with '/' separators
+		std::string mPath;
+		fs::path mSource;
+		uint64_t mSize;
+		uint64_t mOffset;
+	};
+
+	uint64_t AlignUp( uint64_t value, uint64_t alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	using namespace AssetArchiveFormat;
+
+	if ( argc != 3 )
+	{
+		printf( "Usage: %s <assets folder> <output archive>\n", argv[ 0 ] );
+		return 1;
+	}
+
+	const fs::path root = argv[ 1 ];
+	const fs::path output = argv[ 2 ];
+
+	std::error_code error;
+	if ( !fs::is_directory( root, error ) )
+	{
+		printf( "%s is not a folder!\n", root.string().c_str() );
+		return 1;
+	}
+
+	// Gather the files, sorted so the archive is reproducible
+	std::vector<PackedFile> files;
+	for ( const fs::directory_entry& entry : fs::recursive_directory_iterator( root ) )
+	{
+		if ( !entry.is_regular_file() )
+		{
+			continue;
+		}
+
+		std::string path = fs::relative( entry.path(), root ).generic_string();
+		if ( path.size() >= MAX_PATH_LENGTH )
+		{
+			printf( "Skipping %s, the path is longer than %zu characters\n", path.c_str(), MAX_PATH_LENGTH - 1 );
+			continue;
+		}
+
+		files.push_back( { path, entry.path(), static_cast< uint64_t >( entry.file_size() ), 0 } );
+	}
+	std::sort( files.begin(), files.end(), []( const PackedFile& a, const PackedFile& b ) { return a.mPath < b.mPath; } );
+
+	// Lay the entries out after the table of contents, each one aligned
+	Header header = {};
+	std::memcpy( header.mMagic, MAGIC, sizeof( MAGIC ) );
+	header.mVersion = VERSION;
+	header.mEntryCount = static_cast< uint32_t >( files.size() );
+	header.mAlignment = ALIGNMENT;
+
+	uint64_t offset = sizeof( Header ) + files.size() * sizeof( TocEntry );
+	std::vector<TocEntry> toc( files.size() );
+	for ( std::size_t i = 0; i < files.size(); ++i )
+	{
+		offset = AlignUp( offset, ALIGNMENT );
+		files[ i ].mOffset = offset;
+		offset += files[ i ].mSize;
+
+		toc[ i ] = {};
+		toc[ i ].mOffset = files[ i ].mOffset;
+		toc[ i ].mSize = files[ i ].mSize;
+		std::memcpy( toc[ i ].mPath, files[ i ].mPath.c_str(), files[ i ].mPath.size() );
+	}
+
+	std::ofstream archive( output, std::ios::binary | std::ios::trunc );
+	if ( !archive )
+	{
+		printf( "Failed to create %s!\n", output.string().c_str() );
+		return 1;
+	}
+
+	archive.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+	archive.write( reinterpret_cast< const char* >( toc.data() ), static_cast< std::streamsize >( toc.size() * sizeof( TocEntry ) ) );
+
+	std::vector<char> buffer;
+	for ( const PackedFile& file : files )
+	{
+		// Pad up to the entry's aligned offset
+		uint64_t position = static_cast< uint64_t >( archive.tellp() );
+		std::vector<char> padding( file.mOffset - position, 0 );
+		archive.write( padding.data(), static_cast< std::streamsize >( padding.size() ) );
+
+		std::ifstream source( file.mSource, std::ios::binary );
+		buffer.resize( file.mSize );
+		if ( !source.read( buffer.data(), static_cast< std::streamsize >( buffer.size() ) ) )
+		{
+			printf( "Failed to read %s!\n", file.mSource.string().c_str() );
+			return 1;
+		}
+		archive.write( buffer.data(), static_cast< std::streamsize >( buffer.size() ) );
+
+		printf( "%10llu  %s\n", static_cast< unsigned long long >( file.mSize ), file.mPath.c_str() );
+	}
+
+	if ( !archive )
+	{
+		printf( "Failed to write %s!\n", output.string().c_str() );
+		return 1;
+	}
+
+	printf( "Packed %zu assets into %s (%llu bytes)\n", files.size(), output.string().c_str(),
+			static_cast< unsigned long long >( offset ) );
+	return 0;
+}